@@ -0,0 +1,491 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/coff/import_object.hpp>
+#include <zen/coff/object.hpp>
+#include <zen/core/parallel.hpp>
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+ZEN_COFF_ALIGNMENT(zen::coff)
+// Member header of an ar archive, every field is space padded ASCII.
+class archive_member_header
+{
+    struct native
+    {
+        char name[16];
+        char date[12];
+        char user_id[6];
+        char group_id[6];
+        char mode[8];
+        char size[10];
+        char end[2];      // "`\n"
+    };
+
+public:
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return ctx_.end[0] == '`' && ctx_.end[1] == '\n';
+    }
+
+    // Raw name field with the padding removed, e.g. "/", "//", "/123" or "foo.obj/".
+    NODISCARD
+    constexpr
+    auto
+    raw_name() const noexcept -> std::string_view
+    {
+        return trim({ctx_.name, sizeof(ctx_.name)});
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    date() const noexcept -> u64
+    {
+        return decimal({ctx_.date, sizeof(ctx_.date)});
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    size() const noexcept -> u64
+    {
+        return decimal({ctx_.size, sizeof(ctx_.size)});
+    }
+
+private:
+    NODISCARD
+    static
+    constexpr
+    auto
+    trim(
+        const std::string_view field
+    ) noexcept -> std::string_view
+    {
+        const auto last = field.find_last_not_of(' ');
+
+        return last == std::string_view::npos ? std::string_view{} : field.substr(0, last + 1);
+    }
+
+    NODISCARD
+    static
+    constexpr
+    auto
+    decimal(
+        const std::string_view field
+    ) noexcept -> u64
+    {
+        u64 value{};
+
+        for (const auto c : field) {
+            if (c < '0' || c > '9') {
+                break;
+            }
+
+            value = value * 10 + static_cast<u64>(c - '0');
+        }
+
+        return value;
+    }
+
+    native ctx_{};
+};
+
+static_assert(sizeof(archive_member_header) == 60);
+ZEN_RESTORE_ALIGNMENT() //namespace zen::coff
+
+namespace zen::coff {
+// Short import record of an import library member.
+struct short_import
+{
+    const import_object_header* header{};
+    std::string_view            symbol;
+    std::string_view            dll;
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return header != nullptr;
+    }
+};
+
+struct archive_member
+{
+    u32                 offset{};  // File offset of the member header, as stored in the linker members.
+    std::string_view    name;
+    std::span<const u8> data;
+
+    NODISCARD
+    auto
+    is_short_import() const noexcept -> bool
+    {
+        return data.size() >= sizeof(import_object_header)
+            && reinterpret_cast<const import_object_header*>(data.data())->valid();
+    }
+
+    // Zero-copy object view, invalid for short import records.
+    NODISCARD
+    auto
+    object() const noexcept -> coff::object
+    {
+        return is_short_import() ? coff::object{} : coff::object{data};
+    }
+
+    NODISCARD
+    auto
+    short_import() const noexcept -> coff::short_import
+    {
+        if (!is_short_import()) {
+            return {};
+        }
+
+        const auto* const hdr     = reinterpret_cast<const import_object_header*>(data.data());
+        const auto        strings = data.subspan(sizeof(import_object_header));
+        const auto        size    = std::min<szt>(hdr->size_data(), strings.size());
+        const auto*       text    = reinterpret_cast<const char*>(strings.data());
+        const auto        symbol  = std::string_view{text, strnlen(text, size)};
+
+        if (symbol.size() == size) {
+            return {};
+        }
+
+        const auto* const dll = text + symbol.size() + 1;
+
+        return {hdr, symbol, {dll, strnlen(dll, size - symbol.size() - 1)}};
+    }
+};
+
+struct parsed_member
+{
+    const archive_member* member{};
+    coff::object          object;
+    coff::short_import    import;
+};
+
+// Read-only view of an ar archive such as an MSVC static or import library, usually mapped with
+// posix::mapped_file. Symbol lookups go through the second (Microsoft) linker member, whose names
+// are sorted, and fall back to a scan of the first linker member for archives without it.
+class archive
+{
+public:
+    constexpr static char signature[] = "!<arch>\n";
+
+    archive() noexcept = default;
+
+    explicit
+    archive(
+        const std::span<const u8> data
+    )
+    {
+        constexpr auto signature_size = sizeof(signature) - 1;
+
+        if (data.size() < signature_size || std::memcmp(data.data(), signature, signature_size) != 0) {
+            return;
+        }
+
+        std::span<const u8> first_linker;
+        std::span<const u8> second_linker;
+        std::string_view    long_names;
+
+        for (szt offset = signature_size; offset + sizeof(archive_member_header) <= data.size();) {
+            const auto* const hdr  = reinterpret_cast<const archive_member_header*>(data.data() + offset);
+            const auto        body = offset + sizeof(archive_member_header);
+
+            if (!hdr->valid() || hdr->size() > data.size() - body) {
+                return;
+            }
+
+            const auto contents = data.subspan(body, static_cast<szt>(hdr->size()));
+            const auto raw_name = hdr->raw_name();
+
+            if (raw_name == "/") {
+                (first_linker.empty() ? first_linker : second_linker) = contents;
+            } else if (raw_name == "//") {
+                long_names = {reinterpret_cast<const char*>(contents.data()), contents.size()};
+            } else if (!raw_name.starts_with("/<")) {
+                members_.push_back({static_cast<u32>(offset), raw_name, contents});
+            }
+
+            offset = body + contents.size() + (contents.size() & 1);
+        }
+
+        for (auto& member : members_) {
+            member.name = resolve_name(member.name, long_names);
+        }
+
+        parse_second_linker(second_linker) || parse_first_linker(first_linker);
+
+        valid_ = true;
+    }
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return valid_;
+    }
+
+    NODISCARD
+    auto
+    members() const noexcept -> std::span<const archive_member>
+    {
+        return members_;
+    }
+
+    // Member whose header starts at `offset`.
+    NODISCARD
+    auto
+    member_at(
+        const u32 offset
+    ) const noexcept -> const archive_member*
+    {
+        const auto it = std::lower_bound(members_.begin(), members_.end(), offset, [](const archive_member& member, const u32 value) {
+            return member.offset < value;
+        });
+
+        return it != members_.end() && it->offset == offset ? &*it : nullptr;
+    }
+
+    NODISCARD
+    auto
+    num_symbols() const noexcept -> szt
+    {
+        return symbol_names_.size();
+    }
+
+    // Member defining `symbol` according to the linker members.
+    NODISCARD
+    auto
+    find(
+        const std::string_view symbol
+    ) const noexcept -> const archive_member*
+    {
+        if (sorted_) {
+            const auto it = std::lower_bound(symbol_names_.begin(), symbol_names_.end(), symbol);
+
+            if (it == symbol_names_.end() || *it != symbol) {
+                return nullptr;
+            }
+
+            return member_at(symbol_offsets_[static_cast<szt>(it - symbol_names_.begin())]);
+        }
+
+        for (szt i{}; i < symbol_names_.size(); ++i) {
+            if (symbol_names_[i] == symbol) {
+                return member_at(symbol_offsets_[i]);
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Views of every member, spread over up to `threads` workers (0 selects the hardware
+    // concurrency, 1 parses on the calling thread).
+    NODISCARD
+    auto
+    parse(
+        const u32 threads = 1
+    ) const -> std::vector<parsed_member>
+    {
+        std::vector<parsed_member> result(members_.size());
+
+        parallel_for(members_.size(), [&](const szt i) {
+            const auto& member = members_[i];
+
+            result[i].member = &member;
+
+            if (member.is_short_import()) {
+                result[i].import = member.short_import();
+            } else {
+                result[i].object = member.object();
+            }
+        }, threads);
+
+        return result;
+    }
+
+private:
+    NODISCARD
+    static
+    auto
+    resolve_name(
+        const std::string_view raw_name,
+        const std::string_view long_names
+    ) noexcept -> std::string_view
+    {
+        if (raw_name.size() > 1 && raw_name[0] == '/') {
+            szt offset{};
+
+            for (const auto c : raw_name.substr(1)) {
+                if (c < '0' || c > '9') {
+                    return raw_name;
+                }
+
+                offset = offset * 10 + static_cast<szt>(c - '0');
+            }
+
+            if (offset >= long_names.size()) {
+                return {};
+            }
+
+            // MSVC terminates long names with a zero, GNU with "/\n"
+            auto name = long_names.substr(offset);
+
+            name = name.substr(0, std::min(name.find('\0'), name.find('\n')));
+
+            return name.ends_with('/') ? name.substr(0, name.size() - 1) : name;
+        }
+
+        return raw_name.ends_with('/') ? raw_name.substr(0, raw_name.size() - 1) : raw_name;
+    }
+
+    // u32 member count, u32 offsets[count], u32 symbol count, u16 indices[symbols] and the
+    // sorted names, all little endian.
+    auto
+    parse_second_linker(
+        const std::span<const u8> data
+    ) -> bool
+    {
+        if (data.size() < sizeof(u32)) {
+            return false;
+        }
+
+        const auto num_members = bit::load_little<u32>(data.data());
+        auto       cursor      = sizeof(u32) + static_cast<szt>(num_members) * sizeof(u32);
+
+        if (cursor + sizeof(u32) > data.size()) {
+            return false;
+        }
+
+        const auto num_symbols = bit::load_little<u32>(data.data() + cursor);
+
+        cursor += sizeof(u32);
+
+        if (cursor + static_cast<szt>(num_symbols) * sizeof(u16) > data.size()) {
+            return false;
+        }
+
+        const auto* const indices = data.data() + cursor;
+
+        cursor += static_cast<szt>(num_symbols) * sizeof(u16);
+
+        if (!read_names(data.subspan(cursor), num_symbols)) {
+            return false;
+        }
+
+        for (u32 i{}; i < num_symbols; ++i) {
+            const auto index = bit::load_little<u16>(indices + i * sizeof(u16));
+
+            symbol_offsets_.push_back(
+                index != 0 && index <= num_members
+                    ? bit::load_little<u32>(data.data() + sizeof(u32) * index)
+                    : 0
+            );
+        }
+
+        sorted_ = std::is_sorted(symbol_names_.begin(), symbol_names_.end());
+
+        return true;
+    }
+
+    // u32 symbol count, u32 offsets[symbols] and the names, big endian and in member order.
+    auto
+    parse_first_linker(
+        const std::span<const u8> data
+    ) -> bool
+    {
+        if (data.size() < sizeof(u32)) {
+            return false;
+        }
+
+        const auto num_symbols = bit::load_big<u32>(data.data());
+        const auto names       = sizeof(u32) + static_cast<szt>(num_symbols) * sizeof(u32);
+
+        if (names > data.size() || !read_names(data.subspan(names), num_symbols)) {
+            return false;
+        }
+
+        for (u32 i{}; i < num_symbols; ++i) {
+            symbol_offsets_.push_back(bit::load_big<u32>(data.data() + sizeof(u32) * (i + 1)));
+        }
+
+        return true;
+    }
+
+    auto
+    read_names(
+        const std::span<const u8> data,
+        const u32                 count
+    ) -> bool
+    {
+        const auto* text = reinterpret_cast<const char*>(data.data());
+        auto        left = data.size();
+
+        symbol_names_.clear();
+        symbol_names_.reserve(count);
+
+        for (u32 i{}; i < count; ++i) {
+            const auto length = strnlen(text, left);
+
+            if (length == left) {
+                symbol_names_.clear();
+                return false;
+            }
+
+            symbol_names_.emplace_back(text, length);
+
+            text += length + 1;
+            left -= length + 1;
+        }
+
+        return true;
+    }
+
+    std::vector<archive_member>   members_;
+    std::vector<std::string_view> symbol_names_;
+    std::vector<u32>              symbol_offsets_;
+    bool                          sorted_{};
+    bool                          valid_{};
+};
+} //namespace zen::coff
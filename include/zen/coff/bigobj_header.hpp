@@ -0,0 +1,123 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/coff/file_header.hpp>
+#include <array>
+
+ZEN_COFF_ALIGNMENT(zen::coff)
+// ANON_OBJECT_HEADER_BIGOBJ, the header of objects compiled with /bigobj. It replaces the file
+// header and widens the section count and the section numbers of symbols to 32 bits.
+class bigobj_header
+{
+    struct native
+    {
+        u16                sig1;            // Must be 0.
+        u16                sig2;            // Must be 0xFFFF.
+        u16                version;         // 2 or above.
+        machine_id         machine;
+        u32                timedate_stamp;
+        std::array<u8, 16> class_id;
+        u32                size_data;
+        u32                flags;
+        u32                metadata_size;
+        u32                metadata_offset;
+        u32                num_sections;
+        u32                ptr_symbols;
+        u32                num_symbols;
+    };
+
+public:
+    // {D1BAA1C7-BAEE-4BA9-AF20-FAF66AA4DCB8} in its in-file byte order.
+    constexpr static std::array<u8, 16> bigobj_class_id{
+        0xC7, 0xA1, 0xBA, 0xD1, 0xEE, 0xBA, 0xA9, 0x4B,
+        0xAF, 0x20, 0xFA, 0xF6, 0x6A, 0xA4, 0xDC, 0xB8,
+    };
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return bit::little(ctx_.sig1) == 0
+            && bit::little(ctx_.sig2) == 0xFFFF
+            && version() >= 2
+            && ctx_.class_id == bigobj_class_id;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    version() const noexcept -> u16
+    {
+        return bit::little(ctx_.version);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    machine() const noexcept -> machine_id
+    {
+        return bit::little(ctx_.machine);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    timedate_stamp() const noexcept -> u32
+    {
+        return bit::little(ctx_.timedate_stamp);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    num_sections() const noexcept -> u32
+    {
+        return bit::little(ctx_.num_sections);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    ptr_symbols() const noexcept -> u32
+    {
+        return bit::little(ctx_.ptr_symbols);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    num_symbols() const noexcept -> u32
+    {
+        return bit::little(ctx_.num_symbols);
+    }
+
+private:
+    native ctx_{};
+};
+
+static_assert(sizeof(bigobj_header) == 56);
+ZEN_RESTORE_ALIGNMENT() //namespace zen::coff
@@ -0,0 +1,258 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/coff/object.hpp>
+#include <zen/core/hash128.hpp>
+#include <zen/core/parallel.hpp>
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zen::coff {
+struct comdat_member
+{
+    u32         object{};   // Caller supplied object id.
+    u32         section{};  // 1-based section number within that object.
+    std::string symbol;     // The COMDAT symbol naming the section.
+};
+
+struct comdat_group
+{
+    hash128::digest_type       hash{};
+    u32                        size{};
+    std::vector<comdat_member> members;
+
+    // Bytes the linker can drop by keeping a single copy.
+    NODISCARD
+    auto
+    foldable_bytes() const noexcept -> u64
+    {
+        return members.empty() ? 0 : static_cast<u64>(size) * (members.size() - 1);
+    }
+};
+
+struct comdat_report
+{
+    u64                       num_comdats{};
+    u64                       total_bytes{};
+    u64                       foldable_bytes{};
+    std::vector<comdat_group> groups;  // Groups of two or more, largest saving first.
+};
+
+// Identical COMDAT analysis over any number of objects. Every non-writable, non-associative COMDAT
+// section is hashed together with its characteristics and relocations, where each relocation
+// target is named by its symbol: external symbols by name, symbols inside another COMDAT by that
+// COMDAT's symbol plus offset, and anything else by object and section so it never matches across
+// objects. Only the hashes and COMDAT names are kept, so objects can be unmapped right after add().
+class comdat_folding
+{
+public:
+    // Safe to call from several threads at once.
+    auto
+    add(
+        const object& obj,
+        const u32     object_id
+    ) -> void
+    {
+        const auto sections = obj.sections();
+
+        std::vector<std::string_view> leaders(sections.size() + 1);
+        std::vector<u8>               associative(sections.size() + 1);
+
+        for (auto it = obj.symbols().begin(); it != obj.symbols().end(); ++it) {
+            const auto sym    = *it;
+            const auto number = sym.section_number();
+
+            if (number <= 0 || static_cast<szt>(number) > sections.size()) {
+                continue;
+            }
+
+            if (sym.storage_class() == storage_class_id::private_symbol && sym.value() == 0 && it.aux().size() >= 15) {
+                // section definition auxiliary record, selection 5 is IMAGE_COMDAT_SELECT_ASSOCIATIVE
+                associative[number] = it.aux()[14] == 5;
+            } else if (sym.is_external() && leaders[number].empty()) {
+                leaders[number] = obj.symbol_name(sym);
+            }
+        }
+
+        std::vector<std::pair<hash128::digest_type, comdat_record>> records;
+
+        for (szt i{}; i < sections.size(); ++i) {
+            const auto& scn    = sections[i];
+            const auto  flags  = scn.characteristics();
+            const auto  number = i + 1;
+
+            if (!flags.lnk_comdat || flags.mem_write || associative[number] || leaders[number].empty()) {
+                continue;
+            }
+
+            hash128 hasher;
+
+            // scalars go in as little endian, the key doesn't depend on the host
+            const auto put = [&hasher](const auto value) {
+                const auto little = bit::little(value);
+
+                hasher.update(&little, sizeof(little));
+            };
+
+            const auto data = obj.section_data(scn);
+
+            put(flags.flags);
+            put(scn.size_raw_data());
+            hasher.update(data);
+
+            for (const auto& rel : obj.relocs(scn)) {
+                put(rel.virtual_address());
+                put(rel.type());
+
+                const auto target = obj.symbol_at(rel.symbol_index());
+
+                if (!target) {
+                    put(object_id);
+                    put(rel.symbol_index());
+                    continue;
+                }
+
+                const auto target_section = target.section_number();
+
+                if (target.is_external() || target.storage_class() == storage_class_id::weak_external) {
+                    const auto name = obj.symbol_name(target);
+
+                    put(u8{1});
+                    hasher.update(name.data(), name.size());
+                } else if (
+                    target_section > 0
+                    && static_cast<szt>(target_section) <= sections.size()
+                    && !leaders[target_section].empty()
+                ) {
+                    const auto name = leaders[target_section];
+
+                    put(u8{2});
+                    hasher.update(name.data(), name.size());
+                    put(target.value());
+                } else {
+                    put(u8{3});
+                    put(object_id);
+                    put(target_section);
+                    put(target.value());
+                }
+            }
+
+            records.push_back({
+                hasher.finalize(),
+                {{object_id, static_cast<u32>(number), std::string{leaders[number]}}, scn.size_raw_data()}
+            });
+        }
+
+        const std::lock_guard lock{mutex_};
+
+        for (auto& [hash, record] : records) {
+            auto& group = groups_[hash];
+
+            group.size = record.size;
+            group.members.push_back(std::move(record.member));
+        }
+    }
+
+    // Maps, adds and releases objects 0 to count - 1 across up to `threads` workers. source(i) has
+    // to return something with bytes() that keeps the object alive, e.g. a posix::mapped_file.
+    template<class Source>
+    auto
+    add_all(
+        const szt count,
+        Source&&  source,
+        const u32 threads = 0
+    ) -> void
+    {
+        parallel_for(count, [&](const szt i) {
+            const auto   file = source(i);
+            const object obj{file.bytes()};
+
+            if (obj) {
+                add(obj, static_cast<u32>(i));
+            }
+        }, threads);
+    }
+
+    NODISCARD
+    auto
+    report() const -> comdat_report
+    {
+        const std::lock_guard lock{mutex_};
+
+        comdat_report result;
+
+        for (const auto& [hash, group] : groups_) {
+            result.num_comdats += group.members.size();
+            result.total_bytes += static_cast<u64>(group.size) * group.members.size();
+
+            if (group.members.size() > 1) {
+                result.foldable_bytes += static_cast<u64>(group.size) * (group.members.size() - 1);
+                result.groups.push_back({hash, group.size, group.members});
+            }
+        }
+
+        std::sort(result.groups.begin(), result.groups.end(), [](const comdat_group& lhs, const comdat_group& rhs) {
+            return lhs.foldable_bytes() != rhs.foldable_bytes()
+                ? lhs.foldable_bytes() > rhs.foldable_bytes()
+                : lhs.hash < rhs.hash;
+        });
+
+        return result;
+    }
+
+private:
+    struct comdat_record
+    {
+        comdat_member member;
+        u32           size{};
+    };
+
+    struct pending_group
+    {
+        u32                        size{};
+        std::vector<comdat_member> members;
+    };
+
+    struct hash_key
+    {
+        NODISCARD
+        auto
+        operator()(
+            const hash128::digest_type& value
+        ) const noexcept -> szt
+        {
+            return static_cast<szt>(bit::load_little<u64>(value.data()));
+        }
+    };
+
+    mutable std::mutex                                                mutex_;
+    std::unordered_map<hash128::digest_type, pending_group, hash_key> groups_;
+};
+} //namespace zen::coff
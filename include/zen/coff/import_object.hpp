@@ -0,0 +1,134 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/coff/file_header.hpp>
+#include <string_view>
+
+ZEN_COFF_ALIGNMENT(zen::coff)
+enum struct import_type : u8
+{
+    code     = 0,  // Executable code.
+    data     = 1,  // Data.
+    constant = 2,  // Specified as CONST in the .def file.
+};
+
+enum struct import_name_type : u8
+{
+    ordinal         = 0,  // Import by ordinal, the hint field is the ordinal.
+    name            = 1,  // Import name equals the public symbol name.
+    name_noprefix   = 2,  // Public symbol name with the leading ?, @ or _ skipped.
+    name_undecorate = 3,  // As name_noprefix, truncated at the first @.
+    name_exportas   = 4,  // Import name is given by a trailing string.
+};
+
+// IMPORT_OBJECT_HEADER, the short form import library members use in place of a full object.
+// The header is followed by the public symbol name and the DLL name, both zero terminated.
+class import_object_header
+{
+    struct native
+    {
+        u16        sig1;           // Must be 0.
+        u16        sig2;           // Must be 0xFFFF.
+        u16        version;
+        machine_id machine;
+        u32        timedate_stamp;
+        u32        size_data;      // Size of the strings following the header.
+        u16        ordinal_hint;
+        u16        type_info;      // Type : 2, NameType : 3, Reserved : 11
+    };
+
+public:
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        // anonymous objects such as bigobj share the signature but have a non-zero version
+        return bit::little(ctx_.sig1) == 0 && bit::little(ctx_.sig2) == 0xFFFF && version() == 0;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    version() const noexcept -> u16
+    {
+        return bit::little(ctx_.version);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    machine() const noexcept -> machine_id
+    {
+        return bit::little(ctx_.machine);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    timedate_stamp() const noexcept -> u32
+    {
+        return bit::little(ctx_.timedate_stamp);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    size_data() const noexcept -> u32
+    {
+        return bit::little(ctx_.size_data);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    ordinal_hint() const noexcept -> u16
+    {
+        return bit::little(ctx_.ordinal_hint);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    type() const noexcept -> import_type
+    {
+        return static_cast<import_type>(bit::little(ctx_.type_info) & 0x3);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    name_type() const noexcept -> import_name_type
+    {
+        return static_cast<import_name_type>((bit::little(ctx_.type_info) >> 2) & 0x7);
+    }
+
+private:
+    native ctx_{};
+};
+
+static_assert(sizeof(import_object_header) == 20);
+ZEN_RESTORE_ALIGNMENT() //namespace zen::coff
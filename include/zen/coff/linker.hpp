@@ -0,0 +1,1217 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/coff/archive.hpp>
+#include <zen/coff/object.hpp>
+#include <zen/coff/symbol_index.hpp>
+#include <zen/core/parallel.hpp>
+#include <zen/nt/checksum.hpp>
+#include <zen/nt/dos_header.hpp>
+#include <zen/nt/nt_headers.hpp>
+#include <zen/nt/directories/imports.hpp>
+#include <zen/nt/reloc_encoder.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace zen::coff {
+struct link_options
+{
+    std::string_view entry{"mainCRTStartup"};  // Also looked up with a leading underscore for i386.
+    u64              image_base{};             // 0 selects 0x140000000 for AMD64 and 0x400000 for i386.
+    win::sub_system  subsystem{win::sub_system::windows_cui};
+    u32              section_alignment{0x1000};
+    u32              file_alignment{0x200};
+    u32              threads{};                // Relocation workers, 0 selects the hardware concurrency.
+};
+
+// Minimal static linker turning AMD64 or i386 objects into a PE32+ or PE32 executable. Sections are
+// merged by the name before their $ suffix (grouped parts ordered by full name), COMDATs keep the
+// copy whose symbol the index resolved to, undefined symbols are pulled from the libraries in the
+// order they were added, either as object members or as short imports, and relocations are applied
+// per section in parallel. The output gets an import directory with thunks for code imports and a
+// .reloc table. No debug info, resources, TLS or exception data beyond what the objects provide;
+// objects and libraries are views and have to outlive the linker.
+class linker
+{
+    constexpr static u32 none = ~0u;
+
+    struct contribution
+    {
+        u32              object{none};  // none for data the linker generates.
+        u32              section{};     // 1-based number within the object.
+        u32              output{};
+        u32              offset{};      // Offset within the output section.
+        u32              size{};
+        u32              alignment{1};
+        std::string_view name{};        // Full section name, orders grouped sections.
+    };
+
+    struct output_section
+    {
+        std::string_view name{};
+        u32              characteristics{};
+        u32              rva{};
+        u32              ptr_raw_data{};
+        u32              size{};
+        u32              size_raw_data{};
+        std::vector<u32> contributions{};
+
+        NODISCARD
+        auto
+        uninitialized() const noexcept -> bool
+        {
+            return (characteristics & std::to_underlying(section_flags::content_code | section_flags::content_initialized_data)) == 0;
+        }
+    };
+
+    struct import_function
+    {
+        std::string_view symbol{};  // Public symbol of the import, e.g. _ExitProcess@4.
+        std::string_view name{};    // Name to import by, empty when importing by ordinal.
+        u16              ordinal_hint{};
+        bool             code{};
+        bool             thunk{};   // Referenced without the __imp_ prefix.
+        u32              iat_rva{};
+        u32              thunk_rva{};
+    };
+
+    struct import_module
+    {
+        std::string_view dll{};
+        std::vector<u32> functions{};
+    };
+
+    struct import_ref
+    {
+        u32  function{};
+        bool iat{};
+    };
+
+    struct target
+    {
+        u64  va{};
+        u32  output{};  // 1-based output section, 0 for absolute symbols.
+        bool valid{};
+    };
+
+public:
+    explicit
+    linker(
+        const link_options& options = {}
+    ) noexcept
+        : options_{options}
+    {}
+
+    // Fails for invalid objects and ones built for another machine than the first.
+    auto
+    add_object(
+        const object& obj
+    ) -> bool
+    {
+        if (!obj || !add_machine(obj.machine())) {
+            return false;
+        }
+
+        index_.add(obj, static_cast<u32>(objects_.size()));
+        objects_.push_back(obj);
+
+        return true;
+    }
+
+    auto
+    add_library(
+        const archive& lib
+    ) -> void
+    {
+        libraries_.push_back(&lib);
+    }
+
+    // Links everything added so far into `out`, which holds the file layout image on success. On
+    // failure unresolved() lists the symbols nothing defined. A linker links once.
+    NODISCARD
+    auto
+    link(
+        std::vector<u8>& out
+    ) -> bool
+    {
+        out.clear();
+
+        if (objects_.empty() || (machine_ != machine_id::amd64 && machine_ != machine_id::i386)) {
+            return false;
+        }
+
+        image_base_ = options_.image_base != 0 ? options_.image_base : is_64_bit() ? 0x140000000ull : 0x400000ull;
+
+        if (!resolve_libraries()) {
+            return false;
+        }
+
+        build_contributions();
+        layout();
+
+        const auto entry = find_entry();
+
+        if (!entry.valid) {
+            return false;
+        }
+
+        out.assign(file_size_, 0);
+
+        std::vector<std::vector<win::reloc_fixup>> bases(contributions_.size() + 1);
+
+        if (!relocate(out, bases)) {
+            out.clear();
+            return false;
+        }
+
+        write_imports(out, bases.back());
+        write_base_relocs(out, bases);
+
+        if (is_64_bit()) {
+            write_headers<true>(out, static_cast<u32>(entry.va - image_base_));
+        } else {
+            write_headers<false>(out, static_cast<u32>(entry.va - image_base_));
+        }
+
+        return true;
+    }
+
+    NODISCARD
+    auto
+    unresolved() const noexcept -> std::span<const std::string>
+    {
+        return unresolved_;
+    }
+
+private:
+    NODISCARD
+    auto
+    is_64_bit() const noexcept -> bool
+    {
+        return machine_ == machine_id::amd64;
+    }
+
+    NODISCARD
+    auto
+    pointer_size() const noexcept -> u32
+    {
+        return is_64_bit() ? sizeof(u64) : sizeof(u32);
+    }
+
+    auto
+    add_machine(
+        const machine_id machine
+    ) noexcept -> bool
+    {
+        if (objects_.empty() && machine_ == machine_id::unknown) {
+            machine_ = machine;
+        }
+
+        return machine == machine_;
+    }
+
+    NODISCARD
+    static
+    constexpr
+    auto
+    align_up(
+        const u32 value,
+        const u32 alignment
+    ) noexcept -> u32
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Pulls library members for undefined symbols until nothing new comes in. Entries are
+    // appended while iterating, so members pulled in get their own references resolved as well.
+    auto
+    resolve_libraries() -> bool
+    {
+        std::unordered_set<const archive_member*> pulled;
+
+        for (szt i{}; i < index_.size(); ++i) {
+            const auto entry = index_.entries()[i];
+
+            if (entry.binding != symbol_binding::undefined || imports_by_symbol_.contains(entry.name)) {
+                continue;
+            }
+
+            for (const auto* lib : libraries_) {
+                const auto* member = lib->find(entry.name);
+
+                if (member == nullptr) {
+                    continue;
+                }
+
+                if (member->is_short_import()) {
+                    add_import(entry.name, member->short_import());
+                } else if (pulled.insert(member).second) {
+                    add_object(member->object());
+                }
+
+                break;
+            }
+        }
+
+        for (const auto& entry : index_.entries()) {
+            if (entry.binding == symbol_binding::undefined
+                && !imports_by_symbol_.contains(entry.name)
+                && !is_image_base(entry.name)
+            ) {
+                unresolved_.emplace_back(entry.name);
+            }
+        }
+
+        return unresolved_.empty();
+    }
+
+    auto
+    add_import(
+        const std::string_view reference,
+        const short_import&    import
+    ) -> void
+    {
+        if (!import || import.header->machine() != machine_) {
+            return;
+        }
+
+        auto [it, inserted] = functions_by_symbol_.try_emplace(import.symbol, static_cast<u32>(functions_.size()));
+
+        if (inserted) {
+            import_function function{
+                .symbol       = import.symbol,
+                .ordinal_hint = import.header->ordinal_hint(),
+                .code         = import.header->type() == import_type::code
+            };
+
+            switch (import.header->name_type()) {
+                case import_name_type::ordinal:
+                    break;
+                case import_name_type::name_noprefix:
+                case import_name_type::name_undecorate:
+                    function.name = import.symbol;
+
+                    if (!function.name.empty() && (function.name[0] == '?' || function.name[0] == '@' || function.name[0] == '_')) {
+                        function.name.remove_prefix(1);
+                    }
+
+                    if (import.header->name_type() == import_name_type::name_undecorate) {
+                        function.name = function.name.substr(0, function.name.find('@'));
+                    }
+                    break;
+                case import_name_type::name_exportas: {
+                    // the export name follows the DLL name within the record
+                    const auto* const strings = reinterpret_cast<const char*>(import.header + 1);
+                    const auto        used    = static_cast<szt>(import.dll.data() - strings) + import.dll.size() + 1;
+                    const auto        size    = import.header->size_data();
+
+                    function.name = used < size ? std::string_view{strings + used, strnlen(strings + used, size - used)} : import.symbol;
+                    break;
+                }
+                default:
+                    function.name = import.symbol;
+                    break;
+            }
+
+            const auto module = std::find_if(modules_.begin(), modules_.end(), [&](const import_module& m) {
+                return m.dll == import.dll;
+            });
+
+            if (module == modules_.end()) {
+                modules_.push_back({import.dll, {it->second}});
+            } else {
+                module->functions.push_back(it->second);
+            }
+
+            functions_.push_back(function);
+        }
+
+        const auto iat = reference.starts_with("__imp_");
+
+        functions_[it->second].thunk |= !iat;
+        imports_by_symbol_.emplace(reference, import_ref{it->second, iat});
+    }
+
+    NODISCARD
+    auto
+    is_image_base(
+        const std::string_view name
+    ) const noexcept -> bool
+    {
+        return name == (is_64_bit() ? "__ImageBase" : "___ImageBase");
+    }
+
+    auto
+    output_for(
+        const std::string_view name,
+        const u32              characteristics
+    ) -> u32
+    {
+        auto [it, inserted] = outputs_by_name_.try_emplace(name, static_cast<u32>(outputs_.size()));
+
+        if (inserted) {
+            outputs_.push_back({.name = name});
+        }
+
+        outputs_[it->second].characteristics |= characteristics & output_flags;
+
+        return it->second;
+    }
+
+    auto
+    add_contribution(
+        contribution c
+    ) -> void
+    {
+        c.alignment = std::max<u32>(c.alignment, 1);
+
+        outputs_[c.output].contributions.push_back(static_cast<u32>(contributions_.size()));
+        contributions_.push_back(c);
+    }
+
+    // Picks the sections that make it into the image and groups them into output sections.
+    auto
+    build_contributions() -> void
+    {
+        section_map_.resize(objects_.size());
+
+        for (u32 o{}; o < objects_.size(); ++o) {
+            const auto& obj      = objects_[o];
+            const auto  sections = obj.sections();
+
+            std::vector<u32> comdat_symbol(sections.size() + 1, none);
+            std::vector<u32> associated(sections.size() + 1);
+            std::vector<u8>  selection(sections.size() + 1);
+
+            for (auto it = obj.symbols().begin(); it != obj.symbols().end(); ++it) {
+                const auto sym    = *it;
+                const auto number = sym.section_number();
+
+                if (number <= 0 || static_cast<szt>(number) > sections.size()) {
+                    continue;
+                }
+
+                if (sym.storage_class() == storage_class_id::private_symbol && sym.value() == 0 && it.aux().size() >= 15) {
+                    // section definition auxiliary record: associated section number and selection,
+                    // bigobj files keep the high half of the number at offset 16
+                    associated[number] = bit::load_little<u16>(it.aux().data() + 12);
+                    selection[number]  = it.aux()[14];
+
+                    if (obj.is_bigobj() && it.aux().size() >= 18) {
+                        associated[number] |= static_cast<u32>(bit::load_little<u16>(it.aux().data() + 16)) << 16;
+                    }
+                } else if (sym.is_external() && comdat_symbol[number] == none) {
+                    comdat_symbol[number] = it.index();
+                }
+            }
+
+            auto& map = section_map_[o];
+
+            map.assign(sections.size() + 1, none);
+
+            std::vector<u8> keep(sections.size() + 1);
+
+            for (szt number{1}; number <= sections.size(); ++number) {
+                const auto flags = sections[number - 1].characteristics();
+
+                if (flags.lnk_remove || flags.lnk_info || flags.mem_discardable) {
+                    continue;
+                }
+
+                if (flags.lnk_comdat && selection[number] != 5 && comdat_symbol[number] != none) {
+                    // keep the copy the symbol index resolved the COMDAT symbol to
+                    const auto  name = obj.symbol_name(obj.symbol_at(comdat_symbol[number]));
+                    const auto* def  = index_.find(name);
+
+                    keep[number] = def != nullptr && def->object == o && def->index == comdat_symbol[number];
+                } else {
+                    keep[number] = 1;
+                }
+            }
+
+            for (szt number{1}; number <= sections.size(); ++number) {
+                const auto parent = associated[number];
+
+                if (keep[number] && selection[number] == 5 && sections[number - 1].characteristics().lnk_comdat) {
+                    keep[number] = parent != 0 && parent <= sections.size() && keep[parent] && selection[parent] != 5;
+                }
+
+                if (!keep[number]) {
+                    continue;
+                }
+
+                const auto& scn  = sections[number - 1];
+                const auto  name = obj.section_name(scn);
+
+                map[number] = static_cast<u32>(contributions_.size());
+
+                add_contribution({
+                    .object    = o,
+                    .section   = static_cast<u32>(number),
+                    .output    = output_for(name.substr(0, name.find('$')), scn.characteristics().flags),
+                    .size      = scn.size_raw_data(),
+                    .alignment = win::convert_alignment<u32>(scn.characteristics().alignment),
+                    .name      = name
+                });
+            }
+        }
+
+        for (auto& out : outputs_) {
+            std::stable_sort(out.contributions.begin(), out.contributions.end(), [&](const u32 lhs, const u32 rhs) {
+                return contributions_[lhs].name < contributions_[rhs].name;
+            });
+        }
+
+        // common symbols the index settled on get space at the end of .bss
+        for (const auto& entry : index_.entries()) {
+            if (entry.binding != symbol_binding::common) {
+                continue;
+            }
+
+            const auto size = static_cast<u32>(objects_[entry.object].symbol_at(entry.index).value());
+
+            commons_.emplace(entry.name, static_cast<u32>(contributions_.size()));
+
+            add_contribution({
+                .output    = output_for(".bss", std::to_underlying(section_flags::content_uninitialized_data | section_flags::memory_read | section_flags::memory_write)),
+                .size      = size,
+                .alignment = std::min<u32>(std::bit_ceil(std::max<u32>(size, 1)), 32)
+            });
+        }
+
+        u32 thunks{};
+
+        for (auto& function : functions_) {
+            thunks += function.thunk && function.code;
+        }
+
+        if (thunks != 0) {
+            thunks_ = static_cast<u32>(contributions_.size());
+
+            add_contribution({
+                .output    = output_for(".text", std::to_underlying(section_flags::content_code | section_flags::memory_execute | section_flags::memory_read)),
+                .size      = thunks * thunk_size,
+                .alignment = 16
+            });
+        }
+
+        if (!modules_.empty()) {
+            imports_ = static_cast<u32>(contributions_.size());
+
+            add_contribution({
+                .output    = output_for(".idata", std::to_underlying(section_flags::content_initialized_data | section_flags::memory_read | section_flags::memory_write)),
+                .size      = import_size(),
+                .alignment = pointer_size()
+            });
+        }
+
+        // code, read-only data, writable data then uninitialized data
+        const auto rank = [](const output_section& out) {
+            if (out.characteristics & std::to_underlying(section_flags::content_code)) {
+                return 0;
+            }
+            if (out.uninitialized()) {
+                return 3;
+            }
+            return out.characteristics & std::to_underlying(section_flags::memory_write) ? 2 : 1;
+        };
+
+        std::vector<u32> order(outputs_.size());
+
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](const u32 lhs, const u32 rhs) {
+            return rank(outputs_[lhs]) < rank(outputs_[rhs]);
+        });
+
+        std::vector<output_section> sorted;
+
+        sorted.reserve(outputs_.size());
+
+        for (u32 i{}; i < order.size(); ++i) {
+            for (const auto c : outputs_[order[i]].contributions) {
+                contributions_[c].output = i;
+            }
+
+            sorted.push_back(std::move(outputs_[order[i]]));
+        }
+
+        outputs_ = std::move(sorted);
+    }
+
+    NODISCARD
+    auto
+    import_size() const noexcept -> u32
+    {
+        auto size = static_cast<u32>((modules_.size() + 1) * sizeof(win::import_directory));
+
+        for (const auto& module : modules_) {
+            size += static_cast<u32>((module.functions.size() + 1) * pointer_size() * 2);
+        }
+
+        for (const auto& function : functions_) {
+            if (!function.name.empty()) {
+                size += align_up(static_cast<u32>(sizeof(u16) + function.name.size() + 1), 2);
+            }
+        }
+
+        for (const auto& module : modules_) {
+            size += static_cast<u32>(module.dll.size() + 1);
+        }
+
+        return size;
+    }
+
+    NODISCARD
+    auto
+    contribution_rva(
+        const u32 index
+    ) const noexcept -> u32
+    {
+        const auto& c = contributions_[index];
+
+        return outputs_[c.output].rva + c.offset;
+    }
+
+    // Assigns offsets, RVAs and file positions. A section header slot is kept for .reloc.
+    auto
+    layout() -> void
+    {
+        const auto headers = sizeof(win::dos_header)
+            + (is_64_bit() ? sizeof(win::nt_headers<true>) : sizeof(win::nt_headers<false>))
+            + (outputs_.size() + 1) * sizeof(section_header);
+
+        headers_size_ = align_up(static_cast<u32>(headers), options_.file_alignment);
+
+        auto rva  = align_up(headers_size_, options_.section_alignment);
+        auto file = headers_size_;
+
+        for (auto& out : outputs_) {
+            u32 offset{};
+
+            for (const auto index : out.contributions) {
+                auto& c = contributions_[index];
+
+                offset   = align_up(offset, c.alignment);
+                c.offset = offset;
+                offset  += c.size;
+            }
+
+            out.rva           = rva;
+            out.size          = offset;
+            out.size_raw_data = out.uninitialized() ? 0 : align_up(offset, options_.file_alignment);
+            out.ptr_raw_data  = out.size_raw_data != 0 ? file : 0;
+
+            rva  += align_up(std::max<u32>(offset, 1), options_.section_alignment);
+            file += out.size_raw_data;
+        }
+
+        reloc_rva_ = rva;
+        file_size_ = file;
+
+        u32 thunk{};
+
+        for (auto& function : functions_) {
+            if (function.thunk && function.code) {
+                function.thunk_rva = contribution_rva(thunks_) + thunk++ * thunk_size;
+            }
+        }
+
+        if (imports_ != none) {
+            // the IATs follow the descriptors and lookup tables
+            auto iat = contribution_rva(imports_) + static_cast<u32>((modules_.size() + 1) * sizeof(win::import_directory));
+
+            for (const auto& module : modules_) {
+                iat += static_cast<u32>((module.functions.size() + 1) * pointer_size());
+            }
+
+            for (const auto& module : modules_) {
+                for (const auto function : module.functions) {
+                    functions_[function].iat_rva = iat;
+                    iat += pointer_size();
+                }
+
+                iat += pointer_size();
+            }
+        }
+    }
+
+    NODISCARD
+    auto
+    find_entry() -> target
+    {
+        const auto* def = index_.find(options_.entry);
+
+        if (def == nullptr && !is_64_bit()) {
+            def = index_.find("_" + std::string{options_.entry});
+        }
+
+        if (def == nullptr || def->binding != symbol_binding::defined) {
+            unresolved_.emplace_back(options_.entry);
+            return {};
+        }
+
+        return resolve(def->object, def->index);
+    }
+
+    // Final address of symbol `index` of object `object_id`.
+    NODISCARD
+    auto
+    resolve(
+        const u32 object_id,
+        const u32 index,
+        const u32 depth = 0
+    ) const noexcept -> target
+    {
+        const auto& obj = objects_[object_id];
+        const auto  sym = obj.symbol_at(index);
+
+        if (!sym || depth > 4) {
+            return {};
+        }
+
+        const auto number = sym.section_number();
+
+        if (number == -1) {
+            return {static_cast<u32>(sym.value()), 0, true};
+        }
+
+        if (number > 0) {
+            const auto& map = section_map_[object_id];
+
+            if (static_cast<szt>(number) < map.size() && map[number] != none) {
+                const auto& c = contributions_[map[number]];
+
+                return {image_base_ + outputs_[c.output].rva + c.offset + static_cast<u32>(sym.value()), c.output + 1, true};
+            }
+
+            // a discarded COMDAT copy, externals resolve to the kept one below
+            if (!sym.is_external()) {
+                return {};
+            }
+        } else if (number < -1) {
+            return {};
+        }
+
+        const auto name = obj.symbol_name(sym);
+
+        if (const auto* def = index_.find(name)) {
+            if (def->binding == symbol_binding::defined && (def->object != object_id || def->index != index)) {
+                return resolve(def->object, def->index, depth + 1);
+            }
+
+            if (def->binding == symbol_binding::common) {
+                const auto c = commons_.at(def->name);
+
+                return {image_base_ + contribution_rva(c), contributions_[c].output + 1, true};
+            }
+        }
+
+        if (const auto it = imports_by_symbol_.find(name); it != imports_by_symbol_.end()) {
+            const auto& function = functions_[it->second.function];
+
+            if (it->second.iat) {
+                return {image_base_ + function.iat_rva, contributions_[imports_].output + 1, true};
+            }
+
+            return function.code ? target{image_base_ + function.thunk_rva, contributions_[thunks_].output + 1, true} : target{};
+        }
+
+        if (is_image_base(name)) {
+            return {image_base_, 0, true};
+        }
+
+        // unresolved weak externals fall back to the symbol named by their auxiliary record
+        if (sym.storage_class() == storage_class_id::weak_external && sym.num_auxiliary() != 0) {
+            const auto* aux = reinterpret_cast<const u8*>(&sym.name()) + (sym.extended() ? sizeof(symbol_ex) : sizeof(symbol));
+
+            return resolve(object_id, bit::load_little<u32>(aux), depth + 1);
+        }
+
+        return {};
+    }
+
+    // Copies every section into place and applies its relocations, one section per task.
+    NODISCARD
+    auto
+    relocate(
+        std::vector<u8>&                            out,
+        std::vector<std::vector<win::reloc_fixup>>& bases
+    ) const -> bool
+    {
+        std::atomic<bool> failed{};
+
+        parallel_for(contributions_.size(), [&](const szt i) {
+            const auto& c   = contributions_[i];
+            const auto& dst = outputs_[c.output];
+
+            if (c.object == none || dst.size_raw_data == 0) {
+                return;
+            }
+
+            const auto& obj  = objects_[c.object];
+            const auto& scn  = obj.sections()[c.section - 1];
+            const auto  data = obj.section_data(scn);
+            auto* const base = out.data() + dst.ptr_raw_data + c.offset;
+
+            if (scn.characteristics().cnt_uninit_data || data.empty()) {
+                return;
+            }
+
+            std::memcpy(base, data.data(), std::min<szt>(data.size(), c.size));
+
+            for (const auto& rel : obj.relocs(scn)) {
+                if (!apply(c, base, rel, bases[i])) {
+                    failed.store(true, std::memory_order_relaxed);
+                    return;
+                }
+            }
+        }, options_.threads);
+
+        return !failed.load();
+    }
+
+    template<class T>
+    static
+    auto
+    add(
+        u8* const at,
+        const i64 value
+    ) noexcept -> void
+    {
+        T current;
+
+        std::memcpy(&current, at, sizeof(T));
+        current = bit::little(static_cast<T>(bit::little(current) + static_cast<T>(value)));
+        std::memcpy(at, &current, sizeof(T));
+    }
+
+    NODISCARD
+    auto
+    apply(
+        const contribution&            c,
+        u8* const                      data,
+        const reloc&                   rel,
+        std::vector<win::reloc_fixup>& bases
+    ) const -> bool
+    {
+        const auto offset = rel.virtual_address();
+        const auto type   = rel.type();
+
+        if (type == reloc_type::amd64_absolute) {
+            return true;
+        }
+
+        const auto width = is_64_bit() && type == reloc_type::amd64_addr64 ? sizeof(u64) : type == reloc_type::amd64_section ? sizeof(u16) : sizeof(u32);
+
+        if (offset > c.size || c.size - offset < width) {
+            return false;
+        }
+
+        const auto t = resolve(c.object, rel.symbol_index());
+
+        if (!t.valid) {
+            return false;
+        }
+
+        auto* const at    = data + offset;
+        const auto  place = outputs_[c.output].rva + c.offset + offset;
+
+        // section and secrel share their values between both machines
+        if (type == reloc_type::amd64_section) {
+            add<u16>(at, t.output);
+            return true;
+        }
+
+        if (type == reloc_type::amd64_secrel) {
+            if (t.output == 0) {
+                return false;
+            }
+
+            add<u32>(at, static_cast<i64>(t.va - image_base_ - outputs_[t.output - 1].rva));
+            return true;
+        }
+
+        if (is_64_bit()) {
+            switch (type) {
+                case reloc_type::amd64_addr64:
+                    add<u64>(at, static_cast<i64>(t.va));
+                    bases.push_back({place, win::reloc_type::based_dir64});
+                    return true;
+                case reloc_type::amd64_addr32: {
+                    const auto value = t.va + bit::load_little<u32>(at);
+
+                    if (value > 0xFFFFFFFFull) {
+                        return false;
+                    }
+
+                    add<u32>(at, static_cast<i64>(t.va));
+                    bases.push_back({place, win::reloc_type::based_high_low});
+                    return true;
+                }
+                case reloc_type::amd64_addr32nb:
+                    add<u32>(at, static_cast<i64>(t.va - image_base_));
+                    return true;
+                case reloc_type::amd64_rel32:
+                case reloc_type::amd64_rel32_1:
+                case reloc_type::amd64_rel32_2:
+                case reloc_type::amd64_rel32_3:
+                case reloc_type::amd64_rel32_4:
+                case reloc_type::amd64_rel32_5: {
+                    const auto next  = image_base_ + place + 4 + (std::to_underlying(type) - std::to_underlying(reloc_type::amd64_rel32));
+                    const auto delta = static_cast<i64>(t.va - next) + static_cast<i32>(bit::load_little<u32>(at));
+
+                    if (delta < INT32_MIN || delta > INT32_MAX) {
+                        return false;
+                    }
+
+                    add<u32>(at, static_cast<i64>(t.va - next));
+                    return true;
+                }
+                default:
+                    return false;
+            }
+        }
+
+        switch (type) {
+            case reloc_type::i386_dir32:
+                add<u32>(at, static_cast<i64>(t.va));
+                bases.push_back({place, win::reloc_type::based_high_low});
+                return true;
+            case reloc_type::i386_dir32nb:
+                add<u32>(at, static_cast<i64>(t.va - image_base_));
+                return true;
+            case reloc_type::i386_rel32:
+                add<u32>(at, static_cast<i64>(t.va - (image_base_ + place + 4)));
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Thunks, descriptors, lookup tables, IATs, hint/name entries and DLL names.
+    auto
+    write_imports(
+        std::vector<u8>&               out,
+        std::vector<win::reloc_fixup>& bases
+    ) const -> void
+    {
+        if (thunks_ != none) {
+            const auto& c   = contributions_[thunks_];
+            auto* const dst = out.data() + outputs_[c.output].ptr_raw_data + c.offset;
+
+            for (const auto& function : functions_) {
+                if (!function.thunk || !function.code) {
+                    continue;
+                }
+
+                // jmp [iat], rip relative on AMD64 and absolute on i386
+                auto*     at      = dst + (function.thunk_rva - contribution_rva(thunks_));
+                const u32 operand = bit::little(is_64_bit()
+                    ? function.iat_rva - (function.thunk_rva + 6)
+                    : static_cast<u32>(image_base_ + function.iat_rva));
+
+                at[0] = 0xFF;
+                at[1] = 0x25;
+                std::memcpy(at + 2, &operand, sizeof(operand));
+                at[6] = 0xCC;
+                at[7] = 0xCC;
+
+                if (!is_64_bit()) {
+                    bases.push_back({function.thunk_rva + 2, win::reloc_type::based_high_low});
+                }
+            }
+        }
+
+        if (imports_ == none) {
+            return;
+        }
+
+        const auto  rva  = contribution_rva(imports_);
+        auto* const base = out.data() + outputs_[contributions_[imports_].output].ptr_raw_data + contributions_[imports_].offset;
+        const auto  ptr  = pointer_size();
+
+        auto lookup = static_cast<u32>((modules_.size() + 1) * sizeof(win::import_directory));
+        auto names  = lookup;
+
+        for (const auto& module : modules_) {
+            names += static_cast<u32>((module.functions.size() + 1) * ptr * 2);
+        }
+
+        const auto write_thunk = [&](const u32 offset, const u64 value) {
+            const auto little = bit::little(value);
+
+            std::memcpy(base + offset, &little, ptr);
+        };
+
+        for (szt m{}; m < modules_.size(); ++m) {
+            const auto& module     = modules_[m];
+            auto&       descriptor = *reinterpret_cast<win::import_directory*>(base + m * sizeof(win::import_directory));
+
+            descriptor.rva_original_first_thunk(rva + lookup);
+            descriptor.rva_first_thunk(functions_[module.functions.front()].iat_rva);
+
+            for (const auto index : module.functions) {
+                const auto& function = functions_[index];
+                u64         value;
+
+                if (function.name.empty()) {
+                    value = (is_64_bit() ? 1ull << 63 : 1ull << 31) | function.ordinal_hint;
+                } else {
+                    value = rva + names;
+
+                    const auto hint = bit::little(function.ordinal_hint);
+
+                    std::memcpy(base + names, &hint, sizeof(hint));
+                    std::memcpy(base + names + sizeof(hint), function.name.data(), function.name.size());
+
+                    names += align_up(static_cast<u32>(sizeof(u16) + function.name.size() + 1), 2);
+                }
+
+                write_thunk(lookup, value);
+                write_thunk(function.iat_rva - rva, value);
+
+                lookup += ptr;
+            }
+
+            lookup += ptr;
+        }
+
+        for (szt m{}; m < modules_.size(); ++m) {
+            reinterpret_cast<win::import_directory*>(base + m * sizeof(win::import_directory))->rva_name(rva + names);
+
+            std::memcpy(base + names, modules_[m].dll.data(), modules_[m].dll.size());
+            names += static_cast<u32>(modules_[m].dll.size() + 1);
+        }
+    }
+
+    // Sorts the collected fixups and encodes them straight into a trailing .reloc section.
+    auto
+    write_base_relocs(
+        std::vector<u8>&                                  out,
+        const std::vector<std::vector<win::reloc_fixup>>& bases
+    ) -> void
+    {
+        szt count{};
+
+        for (const auto& list : bases) {
+            count += list.size();
+        }
+
+        if (count == 0) {
+            return;
+        }
+
+        std::vector<win::reloc_fixup> all;
+        std::vector<win::reloc_fixup> scratch(count);
+
+        all.reserve(count);
+
+        for (const auto& list : bases) {
+            all.insert(all.end(), list.begin(), list.end());
+        }
+
+        win::sort_relocs(all, scratch);
+
+        reloc_size_ = static_cast<u32>(win::reloc_directory_size(all));
+
+        out.resize(file_size_ + align_up(reloc_size_, options_.file_alignment));
+
+        (void)win::encode_relocs(all, {out.data() + file_size_, reloc_size_});
+    }
+
+    template<bool X64>
+    auto
+    write_headers(
+        std::vector<u8>& out,
+        const u32        entry
+    ) const -> void
+    {
+        auto& dos = *reinterpret_cast<win::dos_header*>(out.data());
+
+        dos.magic(win::dos_header::magic_value);
+        dos.next_hdr_offset(sizeof(win::dos_header));
+
+        auto& nt       = *reinterpret_cast<win::nt_headers<X64>*>(out.data() + sizeof(win::dos_header));
+        auto& file_hdr = nt.file_hdr();
+        auto& opt_hdr  = nt.optional_hdr();
+        auto  sections = static_cast<u16>(outputs_.size() + (reloc_size_ != 0));
+
+        nt.signature(win::nt_headers<X64>::magic_value);
+
+        file_characteristics file_flags{};
+
+        file_flags.executable          = 1;
+        file_flags.large_address_aware = X64;
+        file_flags.machine_32          = !X64;
+
+        file_hdr.machine(machine_);
+        file_hdr.num_sections(sections);
+        file_hdr.size_optional_header(sizeof(win::optional_header<X64>));
+        file_hdr.characteristics(file_flags);
+
+        auto* scn = nt.template sections<false>();
+        u32   size_code{};
+        u32   size_init{};
+        u32   size_uninit{};
+        u32   base_of_code{};
+        u32   base_of_data{};
+
+        for (const auto& out_scn : outputs_) {
+            std::memcpy(scn->name().short_name, out_scn.name.data(), std::min<szt>(out_scn.name.size(), sizeof(scn->name().short_name)));
+
+            scn->virtual_size(out_scn.size);
+            scn->virtual_address(out_scn.rva);
+            scn->size_raw_data(out_scn.size_raw_data);
+            scn->ptr_raw_data(out_scn.ptr_raw_data);
+            scn->characteristics(out_scn.characteristics);
+
+            if (out_scn.characteristics & std::to_underlying(section_flags::content_code)) {
+                size_code   += out_scn.size_raw_data;
+                base_of_code = base_of_code != 0 ? base_of_code : out_scn.rva;
+            } else if (out_scn.uninitialized()) {
+                size_uninit += align_up(out_scn.size, options_.file_alignment);
+            } else {
+                size_init   += out_scn.size_raw_data;
+                base_of_data = base_of_data != 0 ? base_of_data : out_scn.rva;
+            }
+
+            ++scn;
+        }
+
+        auto size_image = reloc_rva_;
+
+        if (reloc_size_ != 0) {
+            std::memcpy(scn->name().short_name, ".reloc", 6);
+
+            scn->virtual_size(reloc_size_);
+            scn->virtual_address(reloc_rva_);
+            scn->size_raw_data(align_up(reloc_size_, options_.file_alignment));
+            scn->ptr_raw_data(file_size_);
+            scn->characteristics(std::to_underlying(section_flags::content_initialized_data | section_flags::memory_discardable | section_flags::memory_read));
+
+            size_init  += scn->size_raw_data();
+            size_image += align_up(reloc_size_, options_.section_alignment);
+        }
+
+        win::dll_characteristics dll_flags{};
+
+        dll_flags.high_entropy_va       = X64;
+        dll_flags.dynamic_base          = 1;
+        dll_flags.nx_compat             = 1;
+        dll_flags.terminal_server_aware = 1;
+
+        opt_hdr.magic(X64 ? win::optional_header_base::magic_value_64_bit : win::optional_header_base::magic_value_32_bit);
+        opt_hdr.linker_version() = win::version16{14, 0};
+        opt_hdr.size_code(size_code);
+        opt_hdr.size_init_data(size_init);
+        opt_hdr.size_uninit_data(size_uninit);
+        opt_hdr.entry_point(entry);
+        opt_hdr.base_of_code(base_of_code);
+
+        if constexpr (!X64) {
+            opt_hdr.base_of_data(base_of_data);
+        }
+
+        opt_hdr.image_base(static_cast<va_t<X64>>(image_base_));
+        opt_hdr.section_alignment(options_.section_alignment);
+        opt_hdr.file_alignment(options_.file_alignment);
+        opt_hdr.os_version()        = win::version32{6, 0};
+        opt_hdr.subsystem_version() = win::version32{6, 0};
+        opt_hdr.size_image(size_image);
+        opt_hdr.size_headers(headers_size_);
+        opt_hdr.subsystem(options_.subsystem);
+        opt_hdr.characteristics(dll_flags);
+        opt_hdr.size_stack_reserve(0x100000);
+        opt_hdr.size_stack_commit(0x1000);
+        opt_hdr.size_heap_reserve(0x100000);
+        opt_hdr.size_heap_commit(0x1000);
+        opt_hdr.num_data_directories(16);
+
+        auto& directories = opt_hdr.data_directories();
+
+        if (imports_ != none) {
+            u32 iat_size{};
+
+            for (const auto& module : modules_) {
+                iat_size += static_cast<u32>((module.functions.size() + 1) * pointer_size());
+            }
+
+            directories.at(win::directory::imports).rva(contribution_rva(imports_));
+            directories.at(win::directory::imports).size(static_cast<u32>((modules_.size() + 1) * sizeof(win::import_directory)));
+            directories.at(win::directory::iat).rva(functions_[modules_.front().functions.front()].iat_rva);
+            directories.at(win::directory::iat).size(iat_size);
+        }
+
+        if (reloc_size_ != 0) {
+            directories.at(win::directory::basereloc).rva(reloc_rva_);
+            directories.at(win::directory::basereloc).size(reloc_size_);
+        }
+
+        opt_hdr.checksum(win::pe_checksum::compute(out));
+    }
+
+    constexpr static u32 thunk_size   = 8;
+    constexpr static u32 output_flags = std::to_underlying(
+        section_flags::content_code
+        | section_flags::content_initialized_data
+        | section_flags::content_uninitialized_data
+        | section_flags::memory_shared
+        | section_flags::memory_execute
+        | section_flags::memory_read
+        | section_flags::memory_write
+    );
+
+    link_options                                          options_;
+    machine_id                                            machine_{machine_id::unknown};
+    u64                                                   image_base_{};
+    std::vector<object>                                   objects_;
+    std::vector<const archive*>                           libraries_;
+    symbol_index                                          index_;
+    std::vector<std::vector<u32>>                         section_map_;
+    std::vector<contribution>                             contributions_;
+    std::vector<output_section>                           outputs_;
+    std::unordered_map<std::string_view, u32>             outputs_by_name_;
+    std::unordered_map<std::string_view, u32>             commons_;
+    std::vector<import_function>                          functions_;
+    std::vector<import_module>                            modules_;
+    std::unordered_map<std::string_view, u32>             functions_by_symbol_;
+    std::unordered_map<std::string_view, import_ref>      imports_by_symbol_;
+    std::vector<std::string>                              unresolved_;
+    u32                                                   thunks_{none};
+    u32                                                   imports_{none};
+    u32                                                   headers_size_{};
+    u32                                                   reloc_rva_{};
+    u32                                                   reloc_size_{};
+    u32                                                   file_size_{};
+};
+} //namespace zen::coff
@@ -0,0 +1,565 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/coff/bigobj_header.hpp>
+#include <zen/coff/file_header.hpp>
+#include <zen/coff/reloc.hpp>
+#include <zen/coff/section_header.hpp>
+#include <zen/coff/symbol.hpp>
+#include <iterator>
+#include <span>
+
+namespace zen::coff {
+// Either a coff::symbol or, in bigobj files, a coff::symbol_ex. The layouts only differ in the
+// width of the section number, so every accessor is a single predictable branch.
+class symbol_ref
+{
+public:
+    constexpr
+    symbol_ref() noexcept = default;
+
+    constexpr
+    symbol_ref(
+        const u8* const record,
+        const bool      extended
+    ) noexcept
+        : record_{ record }
+        , extended_{ extended }
+    {}
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return record_ != nullptr;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    extended() const noexcept -> bool
+    {
+        return extended_;
+    }
+
+    // nullptr for bigobj records.
+    NODISCARD
+    auto
+    standard() const noexcept -> const symbol*
+    {
+        return extended_ ? nullptr : reinterpret_cast<const symbol*>(record_);
+    }
+
+    // nullptr for regular records.
+    NODISCARD
+    auto
+    ex() const noexcept -> const symbol_ex*
+    {
+        return extended_ ? reinterpret_cast<const symbol_ex*>(record_) : nullptr;
+    }
+
+    NODISCARD
+    auto
+    name() const noexcept -> const string&
+    {
+        return *reinterpret_cast<const string*>(record_);
+    }
+
+    NODISCARD
+    auto
+    value() const noexcept -> i32
+    {
+        return extended_ ? ex()->value() : standard()->value();
+    }
+
+    // 1-based section number, 0 for undefined, -1 for absolute and -2 for debug symbols.
+    NODISCARD
+    auto
+    section_number() const noexcept -> i32
+    {
+        if (extended_) {
+            return ex()->section_number();
+        }
+
+        const auto index = standard()->section_index();
+
+        return index >= 0xFF00 ? static_cast<i16>(index) : index;
+    }
+
+    NODISCARD
+    auto
+    type() const noexcept -> u16
+    {
+        return extended_ ? ex()->type() : standard()->type();
+    }
+
+    NODISCARD
+    auto
+    storage_class() const noexcept -> storage_class_id
+    {
+        return extended_ ? ex()->storage_class() : standard()->storage_class();
+    }
+
+    NODISCARD
+    auto
+    num_auxiliary() const noexcept -> u8
+    {
+        return extended_ ? ex()->num_auxiliary() : standard()->num_auxiliary();
+    }
+
+    NODISCARD
+    auto
+    is_function() const noexcept -> bool
+    {
+        return static_cast<derived_type_id>(type() >> 4) == derived_type_id::function;
+    }
+
+    NODISCARD
+    auto
+    is_external() const noexcept -> bool
+    {
+        return storage_class() == storage_class_id::public_symbol;
+    }
+
+    NODISCARD
+    auto
+    is_undefined() const noexcept -> bool
+    {
+        return is_external() && section_number() == 0;
+    }
+
+    NODISCARD
+    auto
+    is_absolute() const noexcept -> bool
+    {
+        return section_number() == -1;
+    }
+
+private:
+    const u8* record_{};
+    bool      extended_{};
+};
+
+// Walks the primary records of a symbol table, auxiliary records are stepped over. index() is the
+// raw table index that relocations refer to.
+class symbol_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = symbol_ref;
+    using difference_type   = std::ptrdiff_t;
+
+    constexpr
+    symbol_iterator() noexcept = default;
+
+    constexpr
+    symbol_iterator(
+        const u8* const table,
+        const u32       index,
+        const u32       count,
+        const bool      extended
+    ) noexcept
+        : table_{ table }
+        , index_{ index }
+        , count_{ count }
+        , extended_{ extended }
+    {}
+
+    NODISCARD
+    constexpr
+    auto
+    index() const noexcept -> u32
+    {
+        return index_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    operator*() const noexcept -> symbol_ref
+    {
+        return {table_ + static_cast<szt>(index_) * stride(), extended_};
+    }
+
+    // Raw auxiliary records of the current symbol, clamped to the table. Each one is stride()
+    // bytes; bigobj pads them to 20 bytes.
+    NODISCARD
+    auto
+    aux() const noexcept -> std::span<const u8>
+    {
+        const auto count = std::min<u32>((**this).num_auxiliary(), count_ - index_ - 1);
+
+        return {table_ + (static_cast<szt>(index_) + 1) * stride(), count * stride()};
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    stride() const noexcept -> szt
+    {
+        return extended_ ? sizeof(symbol_ex) : sizeof(symbol);
+    }
+
+    auto
+    operator++() noexcept -> symbol_iterator&
+    {
+        index_ = std::min<u32>(index_ + 1 + (**this).num_auxiliary(), count_);
+
+        return *this;
+    }
+
+    auto
+    operator++(int) noexcept -> symbol_iterator
+    {
+        auto copy = *this;
+
+        ++*this;
+
+        return copy;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    operator==(
+        const symbol_iterator& other
+    ) const noexcept -> bool
+    {
+        return index_ == other.index_;
+    }
+
+private:
+    const u8* table_{};
+    u32       index_{};
+    u32       count_{};
+    bool      extended_{};
+};
+
+class symbol_range
+{
+public:
+    constexpr
+    symbol_range() noexcept = default;
+
+    constexpr
+    symbol_range(
+        const u8* const table,
+        const u32       count,
+        const bool      extended
+    ) noexcept
+        : table_{ table }
+        , count_{ count }
+        , extended_{ extended }
+    {}
+
+    NODISCARD
+    constexpr
+    auto
+    begin() const noexcept -> symbol_iterator
+    {
+        return {table_, 0, count_, extended_};
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    end() const noexcept -> symbol_iterator
+    {
+        return {table_, count_, count_, extended_};
+    }
+
+private:
+    const u8* table_{};
+    u32       count_{};
+    bool      extended_{};
+};
+
+// Read-only view of a COFF object file (.obj) held in memory, typically a posix::mapped_file.
+// Regular and bigobj files are told apart by their header and share the same interface. The
+// constructor checks that the headers, section table, symbol table and string table lie inside
+// the buffer; everything else is read in place on demand, long names are only looked up in the
+// string table when they are asked for.
+class object
+{
+public:
+    constexpr
+    object() noexcept = default;
+
+    explicit
+    object(
+        const std::span<const u8> data
+    ) noexcept
+    {
+        szt sections_begin;
+        u32 ptr_symbols;
+
+        if (
+            data.size() >= sizeof(bigobj_header)
+            && reinterpret_cast<const bigobj_header*>(data.data())->valid()
+        ) {
+            const auto* const hdr = reinterpret_cast<const bigobj_header*>(data.data());
+
+            sections_begin = sizeof(bigobj_header);
+            num_sections_  = hdr->num_sections();
+            ptr_symbols    = hdr->ptr_symbols();
+            num_symbols_   = hdr->num_symbols();
+            machine_       = hdr->machine();
+            extended_      = true;
+        } else if (data.size() >= sizeof(file_header)) {
+            const auto* const hdr = reinterpret_cast<const file_header*>(data.data());
+
+            sections_begin = sizeof(file_header) + hdr->size_optional_header();
+            num_sections_  = hdr->num_sections();
+            ptr_symbols    = hdr->ptr_symbols();
+            num_symbols_   = hdr->num_symbols();
+            machine_       = hdr->machine();
+        } else {
+            return;
+        }
+
+        if (sections_begin + static_cast<szt>(num_sections_) * sizeof(section_header) > data.size()) {
+            return;
+        }
+
+        sections_ = reinterpret_cast<const section_header*>(data.data() + sections_begin);
+
+        if (ptr_symbols != 0) {
+            const auto stride      = extended_ ? sizeof(symbol_ex) : sizeof(symbol);
+            const auto symbols_end = static_cast<szt>(ptr_symbols) + static_cast<szt>(num_symbols_) * stride;
+
+            if (symbols_end + sizeof(u32) > data.size()) {
+                return;
+            }
+
+            const auto* const table = reinterpret_cast<const coff::string_table*>(data.data() + symbols_end);
+
+            if (table->size() < sizeof(u32) || symbols_end + table->size() > data.size()) {
+                return;
+            }
+
+            symbols_ = data.data() + ptr_symbols;
+            strings_ = table;
+        } else {
+            num_symbols_ = 0;
+        }
+
+        data_ = data;
+    }
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return !data_.empty();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    is_bigobj() const noexcept -> bool
+    {
+        return extended_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    data() const noexcept -> std::span<const u8>
+    {
+        return data_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    machine() const noexcept -> machine_id
+    {
+        return machine_;
+    }
+
+    // nullptr for bigobj files.
+    NODISCARD
+    auto
+    file_hdr() const noexcept -> const file_header*
+    {
+        return valid() && !extended_ ? reinterpret_cast<const file_header*>(data_.data()) : nullptr;
+    }
+
+    // nullptr for regular files.
+    NODISCARD
+    auto
+    bigobj_hdr() const noexcept -> const bigobj_header*
+    {
+        return valid() && extended_ ? reinterpret_cast<const bigobj_header*>(data_.data()) : nullptr;
+    }
+
+    NODISCARD
+    auto
+    sections() const noexcept -> std::span<const section_header>
+    {
+        return valid() ? std::span<const section_header>{sections_, num_sections_} : std::span<const section_header>{};
+    }
+
+    // 1-based like the section numbers of symbols, nullptr for anything outside the table.
+    NODISCARD
+    auto
+    section(
+        const szt number
+    ) const noexcept -> const section_header*
+    {
+        const auto table = sections();
+
+        return number != 0 && number <= table.size() ? &table[number - 1] : nullptr;
+    }
+
+    NODISCARD
+    auto
+    section_data(
+        const section_header& scn
+    ) const noexcept -> std::span<const u8>
+    {
+        if (scn.characteristics().cnt_uninit_data || !in_bounds(scn.ptr_raw_data(), scn.size_raw_data())) {
+            return {};
+        }
+
+        return data_.subspan(scn.ptr_raw_data(), scn.size_raw_data());
+    }
+
+    // Handles extended relocation counts: with lnk_nreloc_ovfl set the first record holds the
+    // real count and isn't a relocation itself.
+    NODISCARD
+    auto
+    relocs(
+        const section_header& scn
+    ) const noexcept -> std::span<const reloc>
+    {
+        szt  count = scn.num_relocs();
+        auto first = static_cast<szt>(scn.ptr_relocs());
+
+        if (scn.characteristics().lnk_nreloc_ovfl && count == 0xFFFF) {
+            if (!in_bounds(first, sizeof(reloc))) {
+                return {};
+            }
+
+            count  = reinterpret_cast<const reloc*>(data_.data() + first)->virtual_address();
+            count  = count != 0 ? count - 1 : 0;
+            first += sizeof(reloc);
+        }
+
+        if (count == 0 || !in_bounds(first, count * sizeof(reloc))) {
+            return {};
+        }
+
+        return {reinterpret_cast<const reloc*>(data_.data() + first), count};
+    }
+
+    NODISCARD
+    auto
+    string_table() const noexcept -> const coff::string_table*
+    {
+        return strings_;
+    }
+
+    // Number of raw records, auxiliary ones included.
+    NODISCARD
+    auto
+    num_symbols() const noexcept -> u32
+    {
+        return valid() ? num_symbols_ : 0;
+    }
+
+    NODISCARD
+    auto
+    symbols() const noexcept -> symbol_range
+    {
+        return {symbols_, num_symbols(), extended_};
+    }
+
+    // Raw table index, as used by relocations.
+    NODISCARD
+    auto
+    symbol_at(
+        const u32 index
+    ) const noexcept -> symbol_ref
+    {
+        if (index >= num_symbols()) {
+            return {};
+        }
+
+        return {symbols_ + static_cast<szt>(index) * (extended_ ? sizeof(symbol_ex) : sizeof(symbol)), extended_};
+    }
+
+    NODISCARD
+    auto
+    symbol_name(
+        const symbol_ref sym
+    ) const noexcept -> std::string_view
+    {
+        return sym.name().get(strings_);
+    }
+
+    NODISCARD
+    auto
+    section_name(
+        const section_header& scn
+    ) const noexcept -> std::string_view
+    {
+        return scn.name().string(strings_);
+    }
+
+private:
+    NODISCARD
+    auto
+    in_bounds(
+        const szt offset,
+        const szt size
+    ) const noexcept -> bool
+    {
+        return offset <= data_.size() && size <= data_.size() - offset;
+    }
+
+    std::span<const u8>       data_;
+    const section_header*     sections_{};
+    const u8*                 symbols_{};
+    const coff::string_table* strings_{};
+    u32                       num_sections_{};
+    u32                       num_symbols_{};
+    machine_id                machine_{};
+    bool                      extended_{};
+};
+} //namespace zen::coff
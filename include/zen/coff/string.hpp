@@ -25,6 +25,8 @@
 #pragma once
 
 #include <zen/core/bit.hpp>
+#include <algorithm>
+#include <cstdlib>
 
 ZEN_COFF_ALIGNMENT(zen::coff)
 struct string_table
@@ -96,7 +98,7 @@ struct string_table
         const szt offset
     ) const noexcept -> std::string_view
     {
-        if (offset > 4) {
+        if (offset >= sizeof(u32) && offset < size()) {
             const auto* const start = begin() + offset;
             const char* const stop  = end();
 
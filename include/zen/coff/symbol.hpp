@@ -120,9 +120,240 @@ class symbol
         u8               num_auxiliary;
     };
 
+public:
+    NODISCARD
+    constexpr
+    auto
+    name() noexcept -> string&
+    {
+        return ctx_.name;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    name() const noexcept -> const string&
+    {
+        return const_cast<symbol*>(this)->name();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    value() const noexcept -> i32
+    {
+        return bit::little(ctx_.value);
+    }
+
+    constexpr
+    auto
+    value(
+        const i32 val
+    ) noexcept -> symbol&
+    {
+        ctx_.value = bit::little(val);
+
+        return *this;
+    }
+
+    // 1-based section number, or one of special_section_id.
+    NODISCARD
+    constexpr
+    auto
+    section_index() const noexcept -> u16
+    {
+        return bit::little(ctx_.section_index);
+    }
+
+    constexpr
+    auto
+    section_index(
+        const u16 val
+    ) noexcept -> symbol&
+    {
+        ctx_.section_index = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    base_type() const noexcept -> base_type_id
+    {
+        return static_cast<base_type_id>(bit::little(ctx_.types.flags) & 0xF);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    derived_type() const noexcept -> derived_type_id
+    {
+        return static_cast<derived_type_id>(bit::little(ctx_.types.flags) >> 4);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    type() const noexcept -> u16
+    {
+        return bit::little(ctx_.types.flags);
+    }
+
+    constexpr
+    auto
+    type(
+        const u16 val
+    ) noexcept -> symbol&
+    {
+        ctx_.types.flags = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    storage_class() const noexcept -> storage_class_id
+    {
+        return ctx_.storage_class;
+    }
+
+    constexpr
+    auto
+    storage_class(
+        const storage_class_id val
+    ) noexcept -> symbol&
+    {
+        ctx_.storage_class = val;
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    num_auxiliary() const noexcept -> u8
+    {
+        return ctx_.num_auxiliary;
+    }
+
+    constexpr
+    auto
+    num_auxiliary(
+        const u8 val
+    ) noexcept -> symbol&
+    {
+        ctx_.num_auxiliary = val;
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    is_function() const noexcept -> bool
+    {
+        return derived_type() == derived_type_id::function;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    is_external() const noexcept -> bool
+    {
+        return storage_class() == storage_class_id::public_symbol;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    is_undefined() const noexcept -> bool
+    {
+        return is_external() && section_index() == static_cast<u16>(special_section_id::symbol_undefined);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    is_absolute() const noexcept -> bool
+    {
+        return section_index() == static_cast<u16>(special_section_id::symbol_absolute);
+    }
+
 private:
     native ctx_{};
 };
 
 static_assert(sizeof(symbol) == 18, "misaligned coff::symbol, probably because enum bitfields are not supported");
+
+// IMAGE_SYMBOL_EX, the symbol record of bigobj files. Auxiliary records are padded to the same
+// 20 bytes.
+class symbol_ex
+{
+    struct native
+    {
+        string           name;
+        i32              value;
+        i32              section_number;
+        u16              type;
+        storage_class_id storage_class;
+        u8               num_auxiliary;
+    };
+
+public:
+    NODISCARD
+    constexpr
+    auto
+    name() const noexcept -> const string&
+    {
+        return ctx_.name;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    value() const noexcept -> i32
+    {
+        return bit::little(ctx_.value);
+    }
+
+    // 1-based section number, 0 for undefined, -1 for absolute and -2 for debug symbols.
+    NODISCARD
+    constexpr
+    auto
+    section_number() const noexcept -> i32
+    {
+        return bit::little(ctx_.section_number);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    type() const noexcept -> u16
+    {
+        return bit::little(ctx_.type);
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    storage_class() const noexcept -> storage_class_id
+    {
+        return ctx_.storage_class;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    num_auxiliary() const noexcept -> u8
+    {
+        return ctx_.num_auxiliary;
+    }
+
+private:
+    native ctx_{};
+};
+
+static_assert(sizeof(symbol_ex) == 20);
 ZEN_RESTORE_ALIGNMENT() //namespace zen::coff
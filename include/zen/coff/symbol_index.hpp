@@ -0,0 +1,233 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/coff/object.hpp>
+#include <zen/core/fnv.hpp>
+#include <algorithm>
+#include <bit>
+#include <string_view>
+#include <vector>
+
+namespace zen::coff {
+enum struct symbol_binding : u8
+{
+    undefined = 0,  // External reference.
+    weak      = 1,  // Weak external, resolves to its default if nothing else defines it.
+    common    = 2,  // Uninitialized common data, the value is its size.
+    defined   = 3,  // Defined in one of the sections.
+};
+
+struct indexed_symbol
+{
+    std::string_view name;
+    u32              object{};  // Caller supplied id of the object that contributed the symbol.
+    u32              index{};   // Raw symbol table index within that object.
+    symbol_binding   binding{};
+};
+
+// Flat open-addressing hash table over the external symbols of any number of objects. Names are
+// views into the objects' symbol and string tables, which have to outlive the index. A name is
+// stored once; a later binding replaces the stored one only if it is stronger (defined > common >
+// weak > undefined), so find() answers "which object defines this" directly.
+class symbol_index
+{
+    struct slot
+    {
+        u32 hash{};
+        u32 entry{empty};
+    };
+
+    constexpr static u32 empty = ~0u;
+
+public:
+    auto
+    reserve(
+        const szt count
+    ) -> void
+    {
+        // grows geometrically, add() calls this for every object
+        if (count > entries_.capacity()) {
+            entries_.reserve(std::max(count, entries_.capacity() * 2));
+        }
+
+        if (count * 2 > slots_.size()) {
+            rehash(std::bit_ceil(count * 2));
+        }
+    }
+
+    // Adds the external symbols of `obj` in a single pass over its symbol table.
+    auto
+    add(
+        const object& obj,
+        const u32     object_id = 0
+    ) -> void
+    {
+        reserve(entries_.size() + obj.num_symbols() / 2);
+
+        for (auto it = obj.symbols().begin(); it != obj.symbols().end(); ++it) {
+            const auto     sym = *it;
+            symbol_binding binding;
+
+            if (sym.storage_class() == storage_class_id::weak_external) {
+                binding = symbol_binding::weak;
+            } else if (!sym.is_external()) {
+                continue;
+            } else if (sym.section_number() != 0) {
+                binding = symbol_binding::defined;
+            } else {
+                binding = sym.value() != 0 ? symbol_binding::common : symbol_binding::undefined;
+            }
+
+            insert({obj.symbol_name(sym), object_id, it.index(), binding});
+        }
+    }
+
+    auto
+    insert(
+        const indexed_symbol& entry
+    ) -> void
+    {
+        if ((entries_.size() + 1) * 2 > slots_.size()) {
+            rehash(std::max<szt>(slots_.size() * 2, 64));
+        }
+
+        const auto hash = hash_name(entry.name);
+
+        for (auto i = hash & mask();; i = (i + 1) & mask()) {
+            auto& s = slots_[i];
+
+            if (s.entry == empty) {
+                s.hash  = hash;
+                s.entry = static_cast<u32>(entries_.size());
+
+                entries_.push_back(entry);
+                return;
+            }
+
+            if (s.hash == hash && entries_[s.entry].name == entry.name) {
+                if (entry.binding > entries_[s.entry].binding) {
+                    entries_[s.entry] = entry;
+                }
+
+                return;
+            }
+        }
+    }
+
+    NODISCARD
+    auto
+    find(
+        const std::string_view name
+    ) const noexcept -> const indexed_symbol*
+    {
+        if (slots_.empty()) {
+            return nullptr;
+        }
+
+        const auto hash = hash_name(name);
+
+        for (auto i = hash & mask();; i = (i + 1) & mask()) {
+            const auto& s = slots_[i];
+
+            if (s.entry == empty) {
+                return nullptr;
+            }
+
+            if (s.hash == hash && entries_[s.entry].name == name) {
+                return &entries_[s.entry];
+            }
+        }
+    }
+
+    NODISCARD
+    auto
+    size() const noexcept -> szt
+    {
+        return entries_.size();
+    }
+
+    NODISCARD
+    auto
+    entries() const noexcept -> std::span<const indexed_symbol>
+    {
+        return entries_;
+    }
+
+    auto
+    clear() noexcept -> void
+    {
+        entries_.clear();
+        slots_.clear();
+    }
+
+private:
+    NODISCARD
+    static
+    auto
+    hash_name(
+        const std::string_view name
+    ) noexcept -> u32
+    {
+        const auto hash = fnv<u64>::text(name);
+
+        return static_cast<u32>(hash ^ (hash >> 32));
+    }
+
+    NODISCARD
+    auto
+    mask() const noexcept -> u32
+    {
+        return static_cast<u32>(slots_.size() - 1);
+    }
+
+    auto
+    rehash(
+        const szt capacity
+    ) -> void
+    {
+        std::vector<slot> slots(capacity);
+
+        for (const auto& s : slots_) {
+            if (s.entry == empty) {
+                continue;
+            }
+
+            auto i = s.hash & static_cast<u32>(capacity - 1);
+
+            while (slots[i].entry != empty) {
+                i = (i + 1) & static_cast<u32>(capacity - 1);
+            }
+
+            slots[i] = s;
+        }
+
+        slots_ = std::move(slots);
+    }
+
+    std::vector<indexed_symbol> entries_;
+    std::vector<slot>           slots_;
+};
+} //namespace zen::coff
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <zen/core/requirements.hpp>
+#include <cstring>
 
 namespace zen::bit {
 template<scalar T>
@@ -109,6 +110,37 @@ big(
     return swap_if<std::endian::little>(value);
 }
 
+// Read a little/big endian value from a location that is not required to be aligned to T.
+template<scalar T>
+NODISCARD
+inline
+auto
+load_little(
+    const void* const src
+) noexcept -> T
+{
+    T value;
+
+    std::memcpy(&value, src, sizeof(T));
+
+    return bit::little(value);
+}
+
+template<scalar T>
+NODISCARD
+inline
+auto
+load_big(
+    const void* const src
+) noexcept -> T
+{
+    T value;
+
+    std::memcpy(&value, src, sizeof(T));
+
+    return bit::big(value);
+}
+
 template<class T>
 requires(std::is_integral_v<T> || std::is_pointer_v<T>)
 NODISCARD
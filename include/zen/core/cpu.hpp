@@ -0,0 +1,140 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/requirements.hpp>
+#if defined(ZEN_TARGET_X86)
+#   if defined(ZEN_CXX_MSVC) || defined(ZEN_CXX_INTEL)
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#endif
+
+namespace zen {
+struct cpu_features
+{
+    bool sse2{};
+    bool ssse3{};
+    bool sse41{};
+    bool avx2{};
+    bool sha{};
+    bool neon{};
+};
+
+namespace detail {
+#if defined(ZEN_TARGET_X86)
+inline
+auto
+cpuid(
+    const u32 leaf,
+    const u32 subleaf,
+    u32       (&regs)[4]
+) noexcept -> void
+{
+#   if defined(ZEN_CXX_MSVC) || defined(ZEN_CXX_INTEL)
+    int info[4]{};
+
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+
+    for (szt i{}; i < 4; ++i) {
+        regs[i] = static_cast<u32>(info[i]);
+    }
+#   else
+    if (!__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3])) {
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    }
+#   endif
+}
+
+NODISCARD
+inline
+auto
+xgetbv() noexcept -> u64
+{
+#   if defined(ZEN_CXX_MSVC) || defined(ZEN_CXX_INTEL)
+    return _xgetbv(0);
+#   else
+    u32 lo{};
+    u32 hi{};
+
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+
+    return static_cast<u64>(hi) << 32 | lo;
+#   endif
+}
+#endif
+
+NODISCARD
+inline
+auto
+detect_cpu_features() noexcept -> cpu_features
+{
+    cpu_features features{};
+
+#if defined(ZEN_TARGET_X86)
+    u32 regs[4]{};
+
+    cpuid(0, 0, regs);
+
+    const auto max_leaf = regs[0];
+
+    if (max_leaf < 1) {
+        return features;
+    }
+
+    cpuid(1, 0, regs);
+
+    features.sse2  = (regs[3] & (1u << 26)) != 0;
+    features.ssse3 = (regs[2] & (1u << 9)) != 0;
+    features.sse41 = (regs[2] & (1u << 19)) != 0;
+
+    // AVX state has to be enabled by the OS as well
+    const auto os_avx = (regs[2] & (1u << 27)) != 0 && (regs[2] & (1u << 28)) != 0 && (xgetbv() & 0x6) == 0x6;
+
+    if (max_leaf >= 7) {
+        cpuid(7, 0, regs);
+
+        features.avx2 = os_avx && (regs[1] & (1u << 5)) != 0;
+        features.sha  = (regs[1] & (1u << 29)) != 0;
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+    features.neon = true;
+#endif
+
+    return features;
+}
+} //namespace detail
+
+NODISCARD
+inline
+auto
+cpu() noexcept -> const cpu_features&
+{
+    static const auto features = detail::detect_cpu_features();
+
+    return features;
+}
+} //namespace zen
@@ -28,6 +28,7 @@
 #undef ZEN_TARGET_32_BIT // defined when the target architecture is 32-bit
 #undef ZEN_TARGET_64_BIT // defined when the target architecture is 64-bit
 #undef ZEN_TARGET_ARM    // defined when compiling with an ARM compiler
+#undef ZEN_TARGET_X86    // defined when compiling for x86 or x86-64
 #undef ZEN_OS_APPLE      // defined when compiling with macOS
 #undef ZEN_OS_LINUX      // defined when compiling with a linux system
 #undef ZEN_OS_POSIX      // defined when compiling under unix/posix systems
@@ -58,6 +59,10 @@
 #   define ZEN_TARGET_ARM 1
 #endif
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__amd64__) || defined(__i386__)
+#   define ZEN_TARGET_X86 1
+#endif
+
 #if defined(_WIN64) || defined(_M_X64) || defined(__MINGW64__) || defined(__aarch64__) || defined(__x86_64__) || defined(__amd64__)
 #   define ZEN_TARGET_64_BIT 1
 #elif defined(_WIN32) || defined(_M_IX86) || defined(__MINGW32__) || defined(__arm__) || defined(__armv7__) || defined(__i386__)
@@ -161,6 +166,14 @@
 #   endif
 #endif //ZEN_DECLSPEC_ALIGN
 
+#if !defined(ZEN_TARGET_FEATURES)
+#   if defined(ZEN_CXX_MSVC) || defined(ZEN_CXX_INTEL)
+#       define ZEN_TARGET_FEATURES(x)
+#   else
+#       define ZEN_TARGET_FEATURES(x) __attribute__((target(x)))
+#   endif
+#endif //ZEN_TARGET_FEATURES
+
 #if !defined(ZEN_TYPED_THISCALL_HOOK_ARGS_X86)
 #   define ZEN_TYPED_THISCALL_HOOK_ARGS_X86(Type) \
         Type* ecx, void* edx
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <zen/core/requirements.hpp>
+#include <span>
 
 namespace zen {
 namespace detail {
@@ -35,6 +36,9 @@ class fnv_1_a
 public:
     using value_type = T;
 
+    constexpr static value_type prime        = PrimeValue;
+    constexpr static value_type offset_basis = OffsetValue;
+
 private:
     template<class C, bool Lowercase>
     requires(std::is_same_v<char, C> || std::is_same_v<wchar_t, C>)
@@ -106,6 +110,41 @@ public:
         return process<Lowercase>(str, SIZE_MAX, offset);
     }
 
+    // Unlike get(), runs over every byte including embedded NULs and returns `offset` for empty
+    // input, so it can continue a running hash.
+    NODISCARD
+    constexpr
+    static
+    auto
+    bytes(
+        const std::span<const u8> data,
+        value_type                offset = OffsetValue
+    ) noexcept -> value_type
+    {
+        for (const auto byte : data) {
+            offset = (offset ^ byte) * PrimeValue;
+        }
+
+        return offset;
+    }
+
+    template<bool Lowercase = false>
+    NODISCARD
+    constexpr
+    static
+    auto
+    text(
+        const std::string_view str,
+        value_type             offset = OffsetValue
+    ) noexcept -> value_type
+    {
+        for (const auto c : str) {
+            offset = (offset ^ static_cast<u8>(character<char, Lowercase>(c))) * PrimeValue;
+        }
+
+        return offset;
+    }
+
     template<bool Lowercase = false>
     NODISCARD
     constexpr
@@ -0,0 +1,214 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/bit.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+
+namespace zen {
+// MurmurHash3 x64/128 with a zero seed, streamed the same way as the zen::crypto hashes so it
+// can stand in for them wherever a fast non-cryptographic 128-bit digest is enough.
+class hash128
+{
+public:
+    using digest_type = std::array<u8, 16>;
+
+    constexpr static szt block_size  = 16;
+    constexpr static szt digest_size = 16;
+
+    hash128() noexcept = default;
+
+    auto
+    reset() noexcept -> void
+    {
+        h1_       = 0;
+        h2_       = 0;
+        buffered_ = 0;
+        length_   = 0;
+    }
+
+    auto
+    update(
+        const void* const data,
+        szt               size
+    ) noexcept -> hash128&
+    {
+        const auto* bytes = static_cast<const u8*>(data);
+
+        length_ += size;
+
+        if (buffered_ != 0) {
+            const auto take = std::min(block_size - buffered_, size);
+
+            std::memcpy(buffer_.data() + buffered_, bytes, take);
+
+            buffered_ += take;
+            bytes     += take;
+            size      -= take;
+
+            if (buffered_ != block_size) {
+                return *this;
+            }
+
+            block(buffer_.data());
+
+            buffered_ = 0;
+        }
+
+        for (; size >= block_size; bytes += block_size, size -= block_size) {
+            block(bytes);
+        }
+
+        if (size != 0) {
+            std::memcpy(buffer_.data(), bytes, size);
+
+            buffered_ = size;
+        }
+
+        return *this;
+    }
+
+    auto
+    update(
+        const std::span<const u8> data
+    ) noexcept -> hash128&
+    {
+        return update(data.data(), data.size());
+    }
+
+    // Returns the digest and resets the hasher for the next message.
+    NODISCARD
+    auto
+    finalize() noexcept -> digest_type
+    {
+        std::memset(buffer_.data() + buffered_, 0, block_size - buffered_);
+
+        if (buffered_ > sizeof(u64)) {
+            h2_ ^= mix2(bit::load_little<u64>(buffer_.data() + sizeof(u64)));
+        }
+
+        if (buffered_ != 0) {
+            h1_ ^= mix1(bit::load_little<u64>(buffer_.data()));
+        }
+
+        h1_ ^= length_;
+        h2_ ^= length_;
+        h1_ += h2_;
+        h2_ += h1_;
+        h1_  = avalanche(h1_);
+        h2_  = avalanche(h2_);
+        h1_ += h2_;
+        h2_ += h1_;
+
+        digest_type digest{};
+
+        for (szt i{}; i < sizeof(u64); ++i) {
+            digest[i]               = static_cast<u8>(h1_ >> (i * 8));
+            digest[i + sizeof(u64)] = static_cast<u8>(h2_ >> (i * 8));
+        }
+
+        reset();
+
+        return digest;
+    }
+
+    NODISCARD
+    static
+    auto
+    hash(
+        const std::span<const u8> data
+    ) noexcept -> digest_type
+    {
+        hash128 hasher;
+
+        hasher.update(data);
+
+        return hasher.finalize();
+    }
+
+private:
+    constexpr static u64 c1 = 0x87C37B91114253D5ull;
+    constexpr static u64 c2 = 0x4CF5AD432745937Full;
+
+    NODISCARD
+    static
+    ZEN_FORCEINLINE
+    auto
+    mix1(
+        const u64 k
+    ) noexcept -> u64
+    {
+        return std::rotl(k * c1, 31) * c2;
+    }
+
+    NODISCARD
+    static
+    ZEN_FORCEINLINE
+    auto
+    mix2(
+        const u64 k
+    ) noexcept -> u64
+    {
+        return std::rotl(k * c2, 33) * c1;
+    }
+
+    NODISCARD
+    static
+    auto
+    avalanche(
+        u64 value
+    ) noexcept -> u64
+    {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDull;
+        value ^= value >> 33;
+        value *= 0xC4CEB9FE1A85EC53ull;
+        value ^= value >> 33;
+
+        return value;
+    }
+
+    ZEN_FORCEINLINE
+    auto
+    block(
+        const u8* const data
+    ) noexcept -> void
+    {
+        h1_ ^= mix1(bit::load_little<u64>(data));
+        h1_  = (std::rotl(h1_, 27) + h2_) * 5 + 0x52DCE729;
+        h2_ ^= mix2(bit::load_little<u64>(data + sizeof(u64)));
+        h2_  = (std::rotl(h2_, 31) + h1_) * 5 + 0x38495AB5;
+    }
+
+    u64                        h1_{};
+    u64                        h2_{};
+    std::array<u8, block_size> buffer_{};
+    szt                        buffered_{};
+    u64                        length_{};
+};
+} //namespace zen
@@ -0,0 +1,372 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/cpu.hpp>
+#include <zen/core/fnv.hpp>
+#include <algorithm>
+#include <array>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#if defined(ZEN_TARGET_X86)
+#   include <immintrin.h>
+#endif
+
+namespace zen::detail {
+// Permutation i of a token is fmix32(token ^ seed[i]), the murmur3 finalizer, which every kernel
+// evaluates identically.
+NODISCARD
+constexpr
+auto
+minhash_mix(
+    u32 value
+) noexcept -> u32
+{
+    value ^= value >> 16;
+    value *= 0x85EBCA6B;
+    value ^= value >> 13;
+    value *= 0xC2B2AE35;
+    value ^= value >> 16;
+
+    return value;
+}
+
+template<szt K>
+consteval
+auto
+minhash_seeds() noexcept -> std::array<u32, K>
+{
+    std::array<u32, K> seeds{};
+    u64                state{0x9E3779B97F4A7C15};
+
+    // splitmix64
+    for (auto& seed : seeds) {
+        auto z = (state += 0x9E3779B97F4A7C15);
+
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+
+        seed = static_cast<u32>(z ^ (z >> 31));
+    }
+
+    return seeds;
+}
+
+inline
+auto
+minhash_update_scalar(
+    const u32* const seeds,
+    u32* const       signature,
+    const szt        k,
+    const u32* const tokens,
+    const szt        count
+) noexcept -> void
+{
+    for (szt t{}; t < count; ++t) {
+        for (szt i{}; i < k; ++i) {
+            signature[i] = std::min(signature[i], minhash_mix(tokens[t] ^ seeds[i]));
+        }
+    }
+}
+
+#if defined(ZEN_TARGET_X86)
+// Eight permutations per register, the running minimum of a group stays in a register while all
+// tokens are run through it.
+ZEN_TARGET_FEATURES("avx2")
+inline
+auto
+minhash_update_avx2(
+    const u32* const seeds,
+    u32* const       signature,
+    const szt        k,
+    const u32* const tokens,
+    const szt        count
+) noexcept -> void
+{
+    const auto c1 = _mm256_set1_epi32(static_cast<int>(0x85EBCA6B));
+    const auto c2 = _mm256_set1_epi32(static_cast<int>(0xC2B2AE35));
+
+    for (szt i{}; i < k; i += 8) {
+        const auto seed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(seeds + i));
+        auto       low  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(signature + i));
+
+        for (szt t{}; t < count; ++t) {
+            auto h = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(tokens[t])), seed);
+
+            h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+            h = _mm256_mullo_epi32(h, c1);
+            h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+            h = _mm256_mullo_epi32(h, c2);
+            h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+
+            low = _mm256_min_epu32(low, h);
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(signature + i), low);
+    }
+}
+#endif
+
+inline
+auto
+minhash_update(
+    const u32* const seeds,
+    u32* const       signature,
+    const szt        k,
+    const u32* const tokens,
+    const szt        count
+) noexcept -> void
+{
+#if defined(ZEN_TARGET_X86)
+    static const auto accelerated = cpu().avx2;
+
+    if (accelerated && k % 8 == 0) {
+        return minhash_update_avx2(seeds, signature, k, tokens, count);
+    }
+#endif
+
+    minhash_update_scalar(seeds, signature, k, tokens, count);
+}
+} //namespace zen::detail
+
+namespace zen {
+// 32-bit token of a string, case insensitive for ASCII. `domain` keeps equal strings from
+// different feature sets apart.
+NODISCARD
+constexpr
+auto
+minhash_token(
+    const std::string_view text,
+    const u32              domain = 0
+) noexcept -> u32
+{
+    const auto hash = fnv<u64>::text<true>(text, fnv<u64>::offset_basis ^ domain);
+
+    return static_cast<u32>(hash ^ (hash >> 32));
+}
+
+template<szt K>
+using minhash_signature = std::array<u32, K>;
+
+// MinHash over a set of 32-bit tokens with K permutations. Tokens can be added one by one or in
+// batches, batching lets the kernel keep each group of permutations in registers.
+template<szt K = 128>
+class minhash
+{
+    static_assert(K % 8 == 0, "the number of permutations has to be a multiple of 8");
+
+public:
+    using signature_type = minhash_signature<K>;
+
+    constexpr static szt size = K;
+
+    minhash() noexcept
+    {
+        reset();
+    }
+
+    auto
+    reset() noexcept -> void
+    {
+        signature_.fill(~0u);
+    }
+
+    auto
+    update(
+        const std::span<const u32> tokens
+    ) noexcept -> minhash&
+    {
+        detail::minhash_update(seeds_.data(), signature_.data(), K, tokens.data(), tokens.size());
+
+        return *this;
+    }
+
+    auto
+    update(
+        const u32 token
+    ) noexcept -> minhash&
+    {
+        return update({&token, 1});
+    }
+
+    NODISCARD
+    auto
+    signature() const noexcept -> const signature_type&
+    {
+        return signature_;
+    }
+
+private:
+    constexpr static auto seeds_ = detail::minhash_seeds<K>();
+
+    signature_type signature_{};
+};
+
+// Estimated Jaccard similarity, the share of permutations whose minimum agrees.
+template<szt K>
+NODISCARD
+auto
+similarity(
+    const minhash_signature<K>& lhs,
+    const minhash_signature<K>& rhs
+) noexcept -> double
+{
+    szt equal{};
+
+    for (szt i{}; i < K; ++i) {
+        equal += lhs[i] == rhs[i];
+    }
+
+    return static_cast<double>(equal) / K;
+}
+
+// LSH banding index: the signature is cut into Bands bands of K / Bands rows and two signatures
+// become candidates once any band matches exactly. Candidates are ranked by their estimated
+// similarity, so a query only touches the buckets it falls into instead of every signature.
+template<szt K = 128, szt Bands = 32>
+class lsh_index
+{
+    static_assert(K % Bands == 0, "the bands have to split the signature evenly");
+
+public:
+    using signature_type = minhash_signature<K>;
+
+    constexpr static szt rows = K / Bands;
+
+    struct match
+    {
+        u32    id{};
+        double similarity{};
+    };
+
+    // Ids are handed out in insertion order starting at 0.
+    auto
+    insert(
+        const signature_type& signature
+    ) -> u32
+    {
+        const auto id = static_cast<u32>(signatures_.size() / K);
+
+        signatures_.insert(signatures_.end(), signature.begin(), signature.end());
+
+        for (szt band{}; band < Bands; ++band) {
+            buckets_[band][band_key(signature, band)].push_back(id);
+        }
+
+        return id;
+    }
+
+    NODISCARD
+    auto
+    size() const noexcept -> szt
+    {
+        return signatures_.size() / K;
+    }
+
+    NODISCARD
+    auto
+    signature(
+        const u32 id
+    ) const noexcept -> std::span<const u32, K>
+    {
+        return std::span<const u32, K>{signatures_.data() + static_cast<szt>(id) * K, K};
+    }
+
+    // Up to `count` candidates ordered by descending similarity, ties by id.
+    NODISCARD
+    auto
+    query(
+        const signature_type& signature,
+        const szt             count,
+        const double          threshold = 0.0
+    ) const -> std::vector<match>
+    {
+        std::vector<u32> candidates;
+
+        for (szt band{}; band < Bands; ++band) {
+            const auto& buckets = buckets_[band];
+
+            if (const auto it = buckets.find(band_key(signature, band)); it != buckets.end()) {
+                candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        std::vector<match> result;
+
+        result.reserve(candidates.size());
+
+        for (const auto id : candidates) {
+            const auto stored = this->signature(id);
+            szt        equal{};
+
+            for (szt i{}; i < K; ++i) {
+                equal += stored[i] == signature[i];
+            }
+
+            if (const auto value = static_cast<double>(equal) / K; value >= threshold) {
+                result.push_back({id, value});
+            }
+        }
+
+        const auto top = std::min(count, result.size());
+
+        std::partial_sort(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(top), result.end(), [](const match& lhs, const match& rhs) {
+            return lhs.similarity != rhs.similarity ? lhs.similarity > rhs.similarity : lhs.id < rhs.id;
+        });
+
+        result.resize(top);
+
+        return result;
+    }
+
+private:
+    NODISCARD
+    static
+    auto
+    band_key(
+        const signature_type& signature,
+        const szt             band
+    ) noexcept -> u64
+    {
+        // FNV-1a over whole rows, with a shift to fold the high bits back down
+        auto key = fnv<u64>::offset_basis;
+
+        for (szt i{}; i < rows; ++i) {
+            key = (key ^ signature[band * rows + i]) * fnv<u64>::prime;
+            key ^= key >> 29;
+        }
+
+        return key;
+    }
+
+    std::vector<u32>                                             signatures_;
+    std::array<std::unordered_map<u64, std::vector<u32>>, Bands> buckets_;
+};
+} //namespace zen
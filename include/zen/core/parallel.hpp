@@ -0,0 +1,85 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/requirements.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace zen {
+NODISCARD
+inline
+auto
+hardware_threads() noexcept -> u32
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Invokes fn(i) for every i in [0, count), spreading the indices over up to `threads` workers
+// (0 selects the hardware concurrency). The calling thread takes part in the work and the
+// function returns once every index has been processed.
+template<class Fn>
+auto
+parallel_for(
+    const szt count,
+    Fn&&      fn,
+    u32       threads = 0
+) -> void
+{
+    if (threads == 0) {
+        threads = hardware_threads();
+    }
+
+    threads = static_cast<u32>(std::min<szt>(threads, count));
+
+    if (threads <= 1) {
+        for (szt i{}; i < count; ++i) {
+            fn(i);
+        }
+
+        return;
+    }
+
+    std::atomic<szt> next{};
+
+    const auto worker = [&] {
+        for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < count; i = next.fetch_add(1, std::memory_order_relaxed)) {
+            fn(i);
+        }
+    };
+
+    std::vector<std::jthread> pool;
+
+    pool.reserve(threads - 1);
+
+    for (u32 i{1}; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+
+    worker();
+}
+} //namespace zen
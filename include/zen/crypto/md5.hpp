@@ -0,0 +1,115 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/crypto/md_hash.hpp>
+
+namespace zen::crypto {
+namespace detail {
+struct md5_traits
+{
+    using state_type = std::array<u32, 4>;
+
+    constexpr static szt         digest_size = 16;
+    constexpr static std::endian byte_order  = std::endian::little;
+    constexpr static state_type  initial_state{
+        0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476,
+    };
+
+    constexpr static u32 sines[64]{
+        0xD76AA478, 0xE8C7B756, 0x242070DB, 0xC1BDCEEE, 0xF57C0FAF, 0x4787C62A, 0xA8304613, 0xFD469501,
+        0x698098D8, 0x8B44F7AF, 0xFFFF5BB1, 0x895CD7BE, 0x6B901122, 0xFD987193, 0xA679438E, 0x49B40821,
+        0xF61E2562, 0xC040B340, 0x265E5A51, 0xE9B6C7AA, 0xD62F105D, 0x02441453, 0xD8A1E681, 0xE7D3FBC8,
+        0x21E1CDE6, 0xC33707D6, 0xF4D50D87, 0x455A14ED, 0xA9E3E905, 0xFCEFA3F8, 0x676F02D9, 0x8D2A4C8A,
+        0xFFFA3942, 0x8771F681, 0x6D9D6122, 0xFDE5380C, 0xA4BEEA44, 0x4BDECFA9, 0xF6BB4B60, 0xBEBFBC70,
+        0x289B7EC6, 0xEAA127FA, 0xD4EF3085, 0x04881D05, 0xD9D4D039, 0xE6DB99E5, 0x1FA27CF8, 0xC4AC5665,
+        0xF4292244, 0x432AFF97, 0xAB9423A7, 0xFC93A039, 0x655B59C3, 0x8F0CCC92, 0xFFEFF47D, 0x85845DD1,
+        0x6FA87E4F, 0xFE2CE6E0, 0xA3014314, 0x4E0811A1, 0xF7537E82, 0xBD3AF235, 0x2AD7D2BB, 0xEB86D391,
+    };
+
+    constexpr static int shifts[16]{
+        7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21,
+    };
+
+    static
+    auto
+    compress(
+        state_type& state,
+        const u8*   data,
+        szt         blocks
+    ) noexcept -> void
+    {
+        for (; blocks != 0; --blocks, data += 64) {
+            u32 m[16];
+
+            for (szt i{}; i < 16; ++i) {
+                m[i] = static_cast<u32>(data[i * 4])
+                    | static_cast<u32>(data[i * 4 + 1]) << 8
+                    | static_cast<u32>(data[i * 4 + 2]) << 16
+                    | static_cast<u32>(data[i * 4 + 3]) << 24;
+            }
+
+            auto a = state[0];
+            auto b = state[1];
+            auto c = state[2];
+            auto d = state[3];
+
+            for (szt i{}; i < 64; ++i) {
+                u32 f;
+                szt g;
+
+                if (i < 16) {
+                    f = (b & c) | (~b & d);
+                    g = i;
+                } else if (i < 32) {
+                    f = (d & b) | (~d & c);
+                    g = (5 * i + 1) % 16;
+                } else if (i < 48) {
+                    f = b ^ c ^ d;
+                    g = (3 * i + 5) % 16;
+                } else {
+                    f = c ^ (b | ~d);
+                    g = (7 * i) % 16;
+                }
+
+                const auto t = d;
+
+                d = c;
+                c = b;
+                b = b + std::rotl(a + f + sines[i] + m[g], shifts[(i / 16) * 4 + i % 4]);
+                a = t;
+            }
+
+            state[0] += a;
+            state[1] += b;
+            state[2] += c;
+            state[3] += d;
+        }
+    }
+};
+} //namespace detail
+
+using md5 = detail::md_hash<detail::md5_traits>;
+} //namespace zen::crypto
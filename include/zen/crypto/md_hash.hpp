@@ -0,0 +1,186 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/requirements.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <span>
+
+namespace zen::crypto::detail {
+// Buffering and padding shared by the Merkle-Damgard hashes. Traits supplies the initial state,
+// the compression function and the byte order used for the message length and the digest.
+template<class Traits>
+class md_hash
+{
+public:
+    using state_type  = typename Traits::state_type;
+    using digest_type = std::array<u8, Traits::digest_size>;
+
+    constexpr static szt block_size  = 64;
+    constexpr static szt digest_size = Traits::digest_size;
+
+    md_hash() noexcept
+    {
+        reset();
+    }
+
+    auto
+    reset() noexcept -> void
+    {
+        state_    = Traits::initial_state;
+        buffered_ = 0;
+        length_   = 0;
+    }
+
+    auto
+    update(
+        const void* const data,
+        szt               size
+    ) noexcept -> md_hash&
+    {
+        const auto* bytes = static_cast<const u8*>(data);
+
+        length_ += size;
+
+        if (buffered_ != 0) {
+            const auto take = std::min(block_size - buffered_, size);
+
+            std::memcpy(buffer_.data() + buffered_, bytes, take);
+
+            buffered_ += take;
+            bytes     += take;
+            size      -= take;
+
+            if (buffered_ != block_size) {
+                return *this;
+            }
+
+            Traits::compress(state_, buffer_.data(), 1);
+
+            buffered_ = 0;
+        }
+
+        if (const auto blocks = size / block_size; blocks != 0) {
+            Traits::compress(state_, bytes, blocks);
+
+            bytes += blocks * block_size;
+            size  -= blocks * block_size;
+        }
+
+        if (size != 0) {
+            std::memcpy(buffer_.data(), bytes, size);
+
+            buffered_ = size;
+        }
+
+        return *this;
+    }
+
+    auto
+    update(
+        const std::span<const u8> data
+    ) noexcept -> md_hash&
+    {
+        return update(data.data(), data.size());
+    }
+
+    // Returns the digest and resets the hasher for the next message.
+    NODISCARD
+    auto
+    finalize() noexcept -> digest_type
+    {
+        const auto bits = length_ * 8;
+
+        buffer_[buffered_++] = 0x80;
+
+        if (buffered_ > block_size - sizeof(u64)) {
+            std::memset(buffer_.data() + buffered_, 0, block_size - buffered_);
+
+            Traits::compress(state_, buffer_.data(), 1);
+
+            buffered_ = 0;
+        }
+
+        std::memset(buffer_.data() + buffered_, 0, block_size - sizeof(u64) - buffered_);
+
+        for (szt i{}; i < sizeof(u64); ++i) {
+            const auto shift = Traits::byte_order == std::endian::big ? (7 - i) * 8 : i * 8;
+
+            buffer_[block_size - sizeof(u64) + i] = static_cast<u8>(bits >> shift);
+        }
+
+        Traits::compress(state_, buffer_.data(), 1);
+
+        digest_type digest{};
+
+        for (szt i{}; i < digest_size; ++i) {
+            const auto word  = state_[i / 4];
+            const auto shift = Traits::byte_order == std::endian::big ? (3 - i % 4) * 8 : (i % 4) * 8;
+
+            digest[i] = static_cast<u8>(word >> shift);
+        }
+
+        reset();
+
+        return digest;
+    }
+
+    NODISCARD
+    static
+    auto
+    hash(
+        const std::span<const u8> data
+    ) noexcept -> digest_type
+    {
+        md_hash hasher;
+
+        hasher.update(data);
+
+        return hasher.finalize();
+    }
+
+private:
+    state_type                 state_{};
+    std::array<u8, block_size> buffer_{};
+    szt                        buffered_{};
+    u64                        length_{};
+};
+
+NODISCARD
+ZEN_FORCEINLINE
+auto
+load_be32(
+    const u8* const src
+) noexcept -> u32
+{
+    return static_cast<u32>(src[0]) << 24
+        | static_cast<u32>(src[1]) << 16
+        | static_cast<u32>(src[2]) << 8
+        | static_cast<u32>(src[3]);
+}
+} //namespace zen::crypto::detail
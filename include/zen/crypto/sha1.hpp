@@ -0,0 +1,213 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/cpu.hpp>
+#include <zen/crypto/md_hash.hpp>
+#if defined(ZEN_TARGET_X86)
+#   include <immintrin.h>
+#endif
+
+namespace zen::crypto {
+namespace detail {
+inline
+auto
+sha1_compress_scalar(
+    std::array<u32, 5>& state,
+    const u8*           data,
+    szt                 blocks
+) noexcept -> void
+{
+    for (; blocks != 0; --blocks, data += 64) {
+        u32 w[80];
+
+        for (szt i{}; i < 16; ++i) {
+            w[i] = load_be32(data + i * 4);
+        }
+
+        for (szt i{16}; i < 80; ++i) {
+            w[i] = std::rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        auto a = state[0];
+        auto b = state[1];
+        auto c = state[2];
+        auto d = state[3];
+        auto e = state[4];
+
+        for (szt i{}; i < 80; ++i) {
+            u32 f;
+            u32 k;
+
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+
+            const auto t = std::rotl(a, 5) + f + e + k + w[i];
+
+            e = d;
+            d = c;
+            c = std::rotl(b, 30);
+            b = a;
+            a = t;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+    }
+}
+
+#if defined(ZEN_TARGET_X86)
+ZEN_TARGET_FEATURES("sha,sse4.1,ssse3")
+inline
+auto
+sha1_rounds(
+    const __m128i abcd,
+    const __m128i e,
+    const szt     function
+) noexcept -> __m128i
+{
+    // the round function selector has to be an immediate
+    switch (function) {
+        case 0:  return _mm_sha1rnds4_epu32(abcd, e, 0);
+        case 1:  return _mm_sha1rnds4_epu32(abcd, e, 1);
+        case 2:  return _mm_sha1rnds4_epu32(abcd, e, 2);
+        default: return _mm_sha1rnds4_epu32(abcd, e, 3);
+    }
+}
+
+ZEN_TARGET_FEATURES("sha,sse4.1,ssse3")
+inline
+auto
+sha1_compress_shani(
+    std::array<u32, 5>& state,
+    const u8*           data,
+    szt                 blocks
+) noexcept -> void
+{
+    const auto mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090A0B0C0D0E0FULL);
+
+    auto abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0x1B);
+    auto e0   = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+    for (; blocks != 0; --blocks, data += 64) {
+        const auto abcd_saved = abcd;
+        const auto e0_saved   = e0;
+
+        __m128i w[4];
+        __m128i e1{};
+
+        // 20 groups of 4 rounds. Group g finishes the schedule of w[g + 1] (msg2), continues
+        // w[g + 2] (xor) and starts w[g + 3] (msg1), indexes are taken modulo 4.
+        for (szt g{}; g < 20; ++g) {
+            const auto k = g % 4;
+
+            if (g < 4) {
+                w[k] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + g * 16)), mask);
+            }
+
+            if (g == 0) {
+                e0   = _mm_add_epi32(e0, w[0]);
+                e1   = abcd;
+                abcd = sha1_rounds(abcd, e0, 0);
+            } else if (g % 2 != 0) {
+                e1   = _mm_sha1nexte_epu32(e1, w[k]);
+                e0   = abcd;
+                abcd = sha1_rounds(abcd, e1, g / 5);
+            } else {
+                e0   = _mm_sha1nexte_epu32(e0, w[k]);
+                e1   = abcd;
+                abcd = sha1_rounds(abcd, e0, g / 5);
+            }
+
+            if (g >= 3 && g <= 18) {
+                w[(k + 1) % 4] = _mm_sha1msg2_epu32(w[(k + 1) % 4], w[k]);
+            }
+
+            if (g >= 2 && g <= 17) {
+                w[(k + 2) % 4] = _mm_xor_si128(w[(k + 2) % 4], w[k]);
+            }
+
+            if (g >= 1 && g <= 16) {
+                w[(k + 3) % 4] = _mm_sha1msg1_epu32(w[(k + 3) % 4], w[k]);
+            }
+        }
+
+        e0   = _mm_sha1nexte_epu32(e0, e0_saved);
+        abcd = _mm_add_epi32(abcd, abcd_saved);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_shuffle_epi32(abcd, 0x1B));
+
+    state[4] = static_cast<u32>(_mm_extract_epi32(e0, 3));
+}
+#endif
+
+struct sha1_traits
+{
+    using state_type = std::array<u32, 5>;
+
+    constexpr static szt         digest_size = 20;
+    constexpr static std::endian byte_order  = std::endian::big;
+    constexpr static state_type  initial_state{
+        0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0,
+    };
+
+    static
+    auto
+    compress(
+        state_type&     state,
+        const u8* const data,
+        const szt       blocks
+    ) noexcept -> void
+    {
+#if defined(ZEN_TARGET_X86)
+        static const auto accelerated = cpu().sha && cpu().sse41 && cpu().ssse3;
+
+        if (accelerated) {
+            return sha1_compress_shani(state, data, blocks);
+        }
+#endif
+
+        sha1_compress_scalar(state, data, blocks);
+    }
+};
+} //namespace detail
+
+using sha1 = detail::md_hash<detail::sha1_traits>;
+} //namespace zen::crypto
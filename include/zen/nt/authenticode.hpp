@@ -0,0 +1,207 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/nt/checksum.hpp>
+#include <zen/nt/directories/security.hpp>
+#include <zen/nt/image.hpp>
+#include <array>
+#include <span>
+#include <vector>
+
+namespace zen::win {
+struct file_range
+{
+    szt offset{};
+    szt size{};
+};
+
+// File ranges covered by the Authenticode digest of a file layout image: everything except the
+// CheckSum field, the security directory entry and the attribute certificate table. Hashing the
+// ranges in order reads straight from the image, nothing is copied.
+template<bool X64 = detail::is_64_bit>
+class authenticode_layout
+{
+public:
+    constexpr
+    authenticode_layout() noexcept = default;
+
+    authenticode_layout(
+        const image<X64>& img,
+        const szt         file_size
+    ) noexcept
+    {
+        const auto* const base     = reinterpret_cast<const u8*>(&img);
+        const auto* const opt      = img.optional_hdr();
+        const auto        checksum = checksum_offset({base, file_size});
+
+        if (checksum == invalid_checksum_offset || opt->size_headers() > file_size) {
+            return;
+        }
+
+        auto cursor = szt{};
+
+        const auto exclude = [&](const szt offset, const szt size) {
+            ranges_[count_++] = {cursor, offset - cursor};
+            cursor            = offset + size;
+        };
+
+        exclude(checksum, sizeof(u32));
+
+        if (opt->num_data_directories() > static_cast<u32>(directory::security)) {
+            const auto& entry  = opt->data_directories().at(directory::security);
+            const auto  offset = static_cast<szt>(reinterpret_cast<const u8*>(&entry) - base);
+
+            if (offset + sizeof(data_directory) > file_size) {
+                return;
+            }
+
+            exclude(offset, sizeof(data_directory));
+
+            // the security directory holds a file offset rather than an rva
+            if (entry.present()) {
+                const auto table = static_cast<szt>(entry.rva());
+                const auto size  = static_cast<szt>(entry.size());
+
+                if (table < cursor || table + size > file_size) {
+                    return;
+                }
+
+                exclude(table, size);
+
+                certificates_ = {table, size};
+            }
+        }
+
+        ranges_[count_++] = {cursor, file_size - cursor};
+        valid_            = true;
+    }
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return valid_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    ranges() const noexcept -> std::span<const file_range>
+    {
+        return {ranges_.data(), valid_ ? count_ : 0};
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    certificate_table() const noexcept -> file_range
+    {
+        return certificates_;
+    }
+
+    template<class Hash>
+    auto
+    hash(
+        const image<X64>& img,
+        Hash&             hasher
+    ) const noexcept -> void
+    {
+        const auto* const base = reinterpret_cast<const u8*>(&img);
+
+        for (const auto& range : ranges()) {
+            hasher.update(base + range.offset, range.size);
+        }
+    }
+
+    // Walks the attribute certificate table, stops at the first entry that doesn't fit.
+    NODISCARD
+    auto
+    certificates(
+        const image<X64>& img
+    ) const -> std::vector<const win_certificate*>
+    {
+        std::vector<const win_certificate*> result;
+
+        const auto* const table = reinterpret_cast<const u8*>(&img) + certificates_.offset;
+
+        for (szt offset{}; offset + win_certificate::header_size <= certificates_.size;) {
+            const auto* const cert = reinterpret_cast<const win_certificate*>(table + offset);
+
+            if (cert->length() < win_certificate::header_size || cert->length() > certificates_.size - offset) {
+                break;
+            }
+
+            result.push_back(cert);
+
+            offset += cert->aligned_length();
+        }
+
+        return result;
+    }
+
+private:
+    std::array<file_range, 4> ranges_{};
+    szt                       count_{};
+    file_range                certificates_{};
+    bool                      valid_{};
+};
+
+// Authenticode digest of a file layout image of `file_size` bytes, Hash is one of the
+// zen::crypto hashers (sha1, sha256).
+template<class Hash, bool X64 = detail::is_64_bit>
+NODISCARD
+auto
+authenticode_digest(
+    const image<X64>&           img,
+    const szt                   file_size,
+    typename Hash::digest_type& digest
+) noexcept -> bool
+{
+    const authenticode_layout<X64> layout{img, file_size};
+
+    if (!layout) {
+        return false;
+    }
+
+    Hash hasher;
+
+    layout.hash(img, hasher);
+
+    digest = hasher.finalize();
+
+    return true;
+}
+} //namespace zen::win
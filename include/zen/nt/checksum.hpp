@@ -0,0 +1,303 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/cpu.hpp>
+#include <zen/nt/dos_header.hpp>
+#include <span>
+#if defined(ZEN_TARGET_X86)
+#   include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   include <arm_neon.h>
+#endif
+
+namespace zen::detail {
+// All kernels return the plain sum of the little endian 16-bit words in [data, data + size), a
+// trailing odd byte counts as a word of its own. The total is folded by the caller.
+NODISCARD
+inline
+auto
+checksum_sum_scalar(
+    const u8* const data,
+    const szt       size
+) noexcept -> u64
+{
+    u64 sum{};
+    szt i{};
+
+    for (; i + 8 <= size; i += 8) {
+        sum += static_cast<u64>(data[i])     | static_cast<u64>(data[i + 1]) << 8;
+        sum += static_cast<u64>(data[i + 2]) | static_cast<u64>(data[i + 3]) << 8;
+        sum += static_cast<u64>(data[i + 4]) | static_cast<u64>(data[i + 5]) << 8;
+        sum += static_cast<u64>(data[i + 6]) | static_cast<u64>(data[i + 7]) << 8;
+    }
+
+    for (; i + 2 <= size; i += 2) {
+        sum += static_cast<u64>(data[i]) | static_cast<u64>(data[i + 1]) << 8;
+    }
+
+    if (i < size) {
+        sum += data[i];
+    }
+
+    return sum;
+}
+
+#if defined(ZEN_TARGET_X86)
+// Sums the low and high bytes of every word separately with psadbw, the 64-bit lanes can't
+// overflow for any realistic input so there is no folding inside the loop.
+ZEN_TARGET_FEATURES("avx2")
+inline
+auto
+checksum_sum_avx2(
+    const u8* const data,
+    const szt       size
+) noexcept -> u64
+{
+    const auto low_mask = _mm256_set1_epi16(0x00FF);
+    const auto zero     = _mm256_setzero_si256();
+
+    auto low  = zero;
+    auto high = zero;
+    szt  i{};
+
+    for (; i + 64 <= size; i += 64) {
+        const auto v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const auto v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+
+        low  = _mm256_add_epi64(low, _mm256_sad_epu8(_mm256_and_si256(v0, low_mask), zero));
+        high = _mm256_add_epi64(high, _mm256_sad_epu8(_mm256_srli_epi16(v0, 8), zero));
+        low  = _mm256_add_epi64(low, _mm256_sad_epu8(_mm256_and_si256(v1, low_mask), zero));
+        high = _mm256_add_epi64(high, _mm256_sad_epu8(_mm256_srli_epi16(v1, 8), zero));
+    }
+
+    const auto total = _mm256_add_epi64(low, _mm256_slli_epi64(high, 8));
+
+    alignas(32) u64 lanes[4];
+
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + checksum_sum_scalar(data + i, size - i);
+}
+#elif defined(__aarch64__) || defined(_M_ARM64)
+inline
+auto
+checksum_sum_neon(
+    const u8* const data,
+    const szt       size
+) noexcept -> u64
+{
+    auto acc0 = vdupq_n_u64(0);
+    auto acc1 = vdupq_n_u64(0);
+    szt  i{};
+
+    for (; i + 32 <= size; i += 32) {
+        const auto v0 = vreinterpretq_u16_u8(vld1q_u8(data + i));
+        const auto v1 = vreinterpretq_u16_u8(vld1q_u8(data + i + 16));
+
+        acc0 = vpadalq_u32(acc0, vpaddlq_u16(v0));
+        acc1 = vpadalq_u32(acc1, vpaddlq_u16(v1));
+    }
+
+    return vaddvq_u64(vaddq_u64(acc0, acc1)) + checksum_sum_scalar(data + i, size - i);
+}
+#endif
+
+NODISCARD
+inline
+auto
+checksum_sum(
+    const u8* const data,
+    const szt       size
+) noexcept -> u64
+{
+#if defined(ZEN_TARGET_X86)
+    static const auto accelerated = cpu().avx2;
+
+    if (accelerated) {
+        return checksum_sum_avx2(data, size);
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    return checksum_sum_neon(data, size);
+#endif
+
+    return checksum_sum_scalar(data, size);
+}
+
+// Ones' complement fold, the result is only zero if the sum is.
+NODISCARD
+constexpr
+auto
+checksum_fold(
+    u64 sum
+) noexcept -> u32
+{
+    while (sum >> 16) {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+
+    return static_cast<u32>(sum);
+}
+} //namespace zen::detail
+
+namespace zen::win {
+constexpr szt invalid_checksum_offset = static_cast<szt>(-1);
+
+// File offset of the CheckSum field, it's at the same place in PE32 and PE32+ headers.
+NODISCARD
+inline
+auto
+checksum_offset(
+    const std::span<const u8> file
+) noexcept -> szt
+{
+    if (file.size() < sizeof(dos_header)) {
+        return invalid_checksum_offset;
+    }
+
+    const auto offset = static_cast<szt>(reinterpret_cast<const dos_header*>(file.data())->next_hdr_offset())
+        + sizeof(u32)
+        + sizeof(file_header)
+        + 64;
+
+    return offset + sizeof(u32) <= file.size() ? offset : invalid_checksum_offset;
+}
+
+// Streaming PE image checksum (CheckSumMappedFile). Chunks have to be passed in file order but
+// can have any size, the CheckSum field itself is treated as zero.
+class pe_checksum
+{
+public:
+    constexpr
+    pe_checksum() noexcept = default;
+
+    explicit
+    constexpr
+    pe_checksum(
+        const szt checksum_offset
+    ) noexcept
+        : skip_{checksum_offset}
+    {}
+
+    auto
+    update(
+        std::span<const u8> chunk
+    ) noexcept -> pe_checksum&
+    {
+        if (skip_ != invalid_checksum_offset && position_ < skip_ + sizeof(u32) && position_ + chunk.size() > skip_) {
+            const auto before = skip_ > position_ ? skip_ - position_ : 0;
+            const auto after  = std::min(chunk.size(), skip_ + sizeof(u32) - position_);
+
+            add(chunk.first(before));
+
+            position_ += after - before;
+
+            add(chunk.subspan(after));
+        } else {
+            add(chunk);
+        }
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    finalize() const noexcept -> u32
+    {
+        return detail::checksum_fold(sum_) + static_cast<u32>(position_);
+    }
+
+    NODISCARD
+    static
+    auto
+    compute(
+        const std::span<const u8> file
+    ) noexcept -> u32
+    {
+        pe_checksum checksum{checksum_offset(file)};
+
+        checksum.update(file);
+
+        return checksum.finalize();
+    }
+
+    // Updates `checksum` of a `file_size` bytes image after the bytes at `offset` were changed
+    // from `old_bytes` to `new_bytes`, only the patched range is read.
+    NODISCARD
+    static
+    auto
+    patch(
+        const u32                 checksum,
+        const szt                 file_size,
+        const szt                 checksum_offset,
+        const szt                 offset,
+        const std::span<const u8> old_bytes,
+        const std::span<const u8> new_bytes
+    ) noexcept -> u32
+    {
+        pe_checksum removed{checksum_offset};
+        pe_checksum added{checksum_offset};
+
+        removed.position_ = offset;
+        added.position_   = offset;
+
+        removed.update(old_bytes);
+        added.update(new_bytes);
+
+        // everything below is modulo 0xFFFF, the folded sum is congruent to the word sum
+        const auto current = static_cast<u64>(static_cast<u32>(checksum - static_cast<u32>(file_size)) % 0xFFFF);
+        const auto sum     = current + added.sum_ % 0xFFFF + (0xFFFF - removed.sum_ % 0xFFFF);
+        const auto folded  = detail::checksum_fold(sum) % 0xFFFF;
+
+        return (folded == 0 ? 0xFFFF : folded) + static_cast<u32>(file_size);
+    }
+
+private:
+    auto
+    add(
+        std::span<const u8> bytes
+    ) noexcept -> void
+    {
+        if (bytes.empty()) {
+            return;
+        }
+
+        // a chunk starting on an odd offset contributes its first byte as a high byte
+        if (position_ % 2 != 0) {
+            sum_      += static_cast<u64>(bytes[0]) << 8;
+            position_ += 1;
+            bytes      = bytes.subspan(1);
+        }
+
+        sum_      += detail::checksum_sum(bytes.data(), bytes.size());
+        position_ += bytes.size();
+    }
+
+    szt skip_{invalid_checksum_offset};
+    szt position_{};
+    u64 sum_{};
+};
+} //namespace zen::win
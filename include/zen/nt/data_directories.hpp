@@ -73,7 +73,10 @@ union data_directories64
     data_directory entries[16]{};
     directories_t  dir;
 
-    data_directories64() noexcept = default;
+    constexpr
+    data_directories64() noexcept
+        : entries{}
+    {}
 
     NODISCARD
     constexpr
@@ -121,7 +124,10 @@ union data_directories32
     data_directory entries[16]{};
     directories_t  dir;
 
-    data_directories32() noexcept = default;
+    constexpr
+    data_directories32() noexcept
+        : entries{}
+    {}
 
     NODISCARD
     constexpr
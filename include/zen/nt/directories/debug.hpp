@@ -0,0 +1,307 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/coff/version.hpp>
+#include <array>
+
+ZEN_WIN32_ALIGNMENT(zen::win)
+enum struct debug_type : u32
+{
+    unknown                = 0,
+    coff                   = 1,
+    codeview               = 2,
+    fpo                    = 3,
+    misc                   = 4,
+    exception              = 5,
+    fixup                  = 6,
+    omap_to_src            = 7,
+    omap_from_src          = 8,
+    borland                = 9,
+    reserved10             = 10,
+    clsid                  = 11,
+    vc_feature             = 12,
+    pogo                   = 13,
+    iltcg                  = 14,
+    mpx                    = 15,
+    repro                  = 16,
+    ex_dll_characteristics = 20,
+};
+
+// IMAGE_DEBUG_DIRECTORY, the data directory holds an array of these.
+class debug_directory
+{
+    struct native
+    {
+        u32        characteristics{};
+        u32        timedate_stamp{};
+        version32  version{};
+        debug_type type{};
+        u32        size_raw_data{};
+        u32        rva_raw_data{};
+        u32        ptr_raw_data{};
+    };
+
+public:
+    constexpr
+    debug_directory() noexcept = default;
+
+    NODISCARD
+    constexpr
+    auto
+    characteristics() const noexcept -> u32
+    {
+        return bit::little(ctx_.characteristics);
+    }
+
+    constexpr
+    auto
+    characteristics(
+        const u32 val
+    ) noexcept -> debug_directory&
+    {
+        ctx_.characteristics = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    timedate_stamp() const noexcept -> u32
+    {
+        return bit::little(ctx_.timedate_stamp);
+    }
+
+    constexpr
+    auto
+    timedate_stamp(
+        const u32 val
+    ) noexcept -> debug_directory&
+    {
+        ctx_.timedate_stamp = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    version() noexcept -> version32&
+    {
+        return ctx_.version;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    version() const noexcept -> const version32&
+    {
+        return const_cast<debug_directory*>(this)->version();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    type() const noexcept -> debug_type
+    {
+        return bit::little(ctx_.type);
+    }
+
+    constexpr
+    auto
+    type(
+        const debug_type val
+    ) noexcept -> debug_directory&
+    {
+        ctx_.type = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    size_raw_data() const noexcept -> u32
+    {
+        return bit::little(ctx_.size_raw_data);
+    }
+
+    constexpr
+    auto
+    size_raw_data(
+        const u32 val
+    ) noexcept -> debug_directory&
+    {
+        ctx_.size_raw_data = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    rva_raw_data() const noexcept -> u32
+    {
+        return bit::little(ctx_.rva_raw_data);
+    }
+
+    constexpr
+    auto
+    rva_raw_data(
+        const u32 val
+    ) noexcept -> debug_directory&
+    {
+        ctx_.rva_raw_data = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    ptr_raw_data() const noexcept -> u32
+    {
+        return bit::little(ctx_.ptr_raw_data);
+    }
+
+    constexpr
+    auto
+    ptr_raw_data(
+        const u32 val
+    ) noexcept -> debug_directory&
+    {
+        ctx_.ptr_raw_data = bit::little(val);
+
+        return *this;
+    }
+
+private:
+    native ctx_{};
+};
+static_assert(sizeof(debug_directory) == 28, "misaligned win::debug_directory");
+
+// CV_INFO_PDB70, the CodeView record the linker points the codeview debug entry at.
+class cv_pdb70
+{
+    struct native
+    {
+        u32                signature{};
+        std::array<u8, 16> guid{};
+        u32                age{};
+        char               pdb_name[ZEN_WIN32_VAR_LEN]{};
+    };
+
+public:
+    constexpr static u32 magic_value = 0x53445352; // 'RSDS'
+    constexpr static u32 guid_offset = sizeof(u32);
+    constexpr static u32 name_offset = guid_offset + sizeof(native::guid) + sizeof(u32);
+
+    constexpr
+    cv_pdb70() noexcept = default;
+
+    NODISCARD
+    constexpr
+    auto
+    signature() const noexcept -> u32
+    {
+        return bit::little(ctx_.signature);
+    }
+
+    constexpr
+    auto
+    signature(
+        const u32 val
+    ) noexcept -> cv_pdb70&
+    {
+        ctx_.signature = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    guid() noexcept -> std::array<u8, 16>&
+    {
+        return ctx_.guid;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    guid() const noexcept -> const std::array<u8, 16>&
+    {
+        return const_cast<cv_pdb70*>(this)->guid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    age() const noexcept -> u32
+    {
+        return bit::little(ctx_.age);
+    }
+
+    constexpr
+    auto
+    age(
+        const u32 val
+    ) noexcept -> cv_pdb70&
+    {
+        ctx_.age = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    pdb_name() noexcept -> char*
+    {
+        return ctx_.pdb_name;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    pdb_name() const noexcept -> const char*
+    {
+        return const_cast<cv_pdb70*>(this)->pdb_name();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return signature() == magic_value;
+    }
+
+private:
+    native ctx_{};
+};
+static_assert(cv_pdb70::name_offset == 24, "misaligned win::cv_pdb70");
+ZEN_RESTORE_ALIGNMENT() //namespace zen::win
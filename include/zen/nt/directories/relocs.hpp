@@ -25,6 +25,7 @@
 #pragma once
 
 #include <zen/core/bit.hpp>
+#include <cstring>
 
 ZEN_WIN32_ALIGNMENT(zen::win)
 enum struct reloc_type : u16
@@ -247,4 +248,68 @@ struct reloc_directory
 {
     reloc_block first_block;
 };
+
+NODISCARD
+constexpr
+auto
+reloc_width(
+    const reloc_type type
+) noexcept -> szt
+{
+    switch (type) {
+        case reloc_type::based_high:
+        case reloc_type::based_low:
+            return sizeof(u16);
+        case reloc_type::based_high_low:
+            return sizeof(u32);
+        case reloc_type::based_dir64:
+            return sizeof(u64);
+        default:
+            return 0;
+    }
+}
+
+inline
+auto
+apply_relocation(
+    void* const      target,
+    const reloc_type type,
+    const i64        delta
+) noexcept -> bool
+{
+    switch (type) {
+        case reloc_type::based_absolute:
+            return true;
+        case reloc_type::based_high: {
+            u16 value{};
+            std::memcpy(&value, target, sizeof(value));
+            value = bit::little(static_cast<u16>(bit::little(value) + static_cast<u16>(static_cast<u64>(delta) >> 16)));
+            std::memcpy(target, &value, sizeof(value));
+            return true;
+        }
+        case reloc_type::based_low: {
+            u16 value{};
+            std::memcpy(&value, target, sizeof(value));
+            value = bit::little(static_cast<u16>(bit::little(value) + static_cast<u16>(delta)));
+            std::memcpy(target, &value, sizeof(value));
+            return true;
+        }
+        case reloc_type::based_high_low: {
+            u32 value{};
+            std::memcpy(&value, target, sizeof(value));
+            value = bit::little(static_cast<u32>(bit::little(value) + static_cast<u32>(delta)));
+            std::memcpy(target, &value, sizeof(value));
+            return true;
+        }
+        case reloc_type::based_dir64: {
+            u64 value{};
+            std::memcpy(&value, target, sizeof(value));
+            value = bit::little(bit::little(value) + static_cast<u64>(delta));
+            std::memcpy(target, &value, sizeof(value));
+            return true;
+        }
+        default:
+            return false;
+    }
+}
 ZEN_RESTORE_ALIGNMENT() // namespace zen::win
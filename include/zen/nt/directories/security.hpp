@@ -0,0 +1,168 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/bit.hpp>
+
+ZEN_WIN32_ALIGNMENT(zen::win)
+enum struct certificate_revision : u16
+{
+    revision_1_0 = 0x0100,
+    revision_2_0 = 0x0200,
+};
+
+enum struct certificate_type : u16
+{
+    x509             = 0x0001,
+    pkcs_signed_data = 0x0002,
+    reserved_1       = 0x0003,
+    ts_stack_signed  = 0x0004,
+};
+
+// WIN_CERTIFICATE, the entries of the attribute certificate table are 8 byte aligned.
+class win_certificate
+{
+    struct native
+    {
+        u32                  length{};
+        certificate_revision revision{};
+        certificate_type     type{};
+        u8                   certificate[ZEN_WIN32_VAR_LEN]{};
+    };
+
+public:
+    constexpr static szt header_size = sizeof(u32) + sizeof(u16) * 2;
+
+    constexpr
+    win_certificate() noexcept = default;
+
+    NODISCARD
+    constexpr
+    auto
+    length() const noexcept -> u32
+    {
+        return bit::little(ctx_.length);
+    }
+
+    constexpr
+    auto
+    length(
+        const u32 val
+    ) noexcept -> win_certificate&
+    {
+        ctx_.length = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    revision() const noexcept -> certificate_revision
+    {
+        return bit::little(ctx_.revision);
+    }
+
+    constexpr
+    auto
+    revision(
+        const certificate_revision val
+    ) noexcept -> win_certificate&
+    {
+        ctx_.revision = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    type() const noexcept -> certificate_type
+    {
+        return bit::little(ctx_.type);
+    }
+
+    constexpr
+    auto
+    type(
+        const certificate_type val
+    ) noexcept -> win_certificate&
+    {
+        ctx_.type = bit::little(val);
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    data() noexcept -> u8*
+    {
+        return ctx_.certificate;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    data() const noexcept -> const u8*
+    {
+        return ctx_.certificate;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    data_size() const noexcept -> szt
+    {
+        return length() > header_size ? length() - header_size : 0;
+    }
+
+    // Size of the entry including the padding up to the next one.
+    NODISCARD
+    constexpr
+    auto
+    aligned_length() const noexcept -> szt
+    {
+        return (static_cast<szt>(length()) + 7) & ~static_cast<szt>(7);
+    }
+
+    NODISCARD
+    auto
+    next() noexcept -> win_certificate*
+    {
+        return reinterpret_cast<win_certificate*>(reinterpret_cast<std::byte*>(this) + aligned_length());
+    }
+
+    NODISCARD
+    auto
+    next() const noexcept -> const win_certificate*
+    {
+        return const_cast<win_certificate*>(this)->next();
+    }
+
+private:
+    native ctx_{};
+};
+ZEN_RESTORE_ALIGNMENT() //namespace zen::win
@@ -387,7 +387,7 @@ public:
     auto
     nt_hdr() const noexcept -> const nt_headers<X64>*
     {
-        return const_cast<dos_header*>(this)->nt_hdr();
+        return const_cast<dos_header*>(this)->template nt_hdr<X64>();
     }
 
     NODISCARD
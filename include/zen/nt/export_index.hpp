@@ -0,0 +1,282 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/nt/directories/exports.hpp>
+#include <zen/nt/image.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace zen::win {
+struct export_entry
+{
+    u32              rva{};
+    std::string_view forward{};  // e.g. "NTDLL.RtlAllocateHeap", empty if not forwarded
+
+    NODISCARD
+    constexpr
+    auto
+    forwarded() const noexcept -> bool
+    {
+        return !forward.empty();
+    }
+};
+
+// Flattened view of an export directory. Names are kept in name pointer table order, which the
+// PE format requires to be sorted, so lookups by name are a binary search. Every string_view
+// points into the image, which therefore has to outlive the index.
+template<bool X64 = detail::is_64_bit>
+class export_index
+{
+public:
+    constexpr
+    export_index() noexcept = default;
+
+    explicit
+    export_index(
+        const image<X64>& img
+    )
+    {
+        const auto* const data_directory = img.directory(win::directory::exports);
+
+        if (!data_directory) {
+            return;
+        }
+
+        const auto* const export_dir = img.template rva_to_ptr<export_directory>(
+            data_directory->rva(),
+            sizeof(export_directory)
+        );
+
+        if (!export_dir) {
+            return;
+        }
+
+        const auto  num_functions = export_dir->num_functions();
+        const auto  num_names     = export_dir->num_names();
+        const auto* functions     = img.template rva_to_ptr<u8>(export_dir->rva_functions(), num_functions * sizeof(u32));
+        const auto* names         = img.template rva_to_ptr<u8>(export_dir->rva_names(), num_names * sizeof(u32));
+        const auto* ordinals      = img.template rva_to_ptr<u8>(export_dir->rva_name_ordinals(), num_names * sizeof(u16));
+
+        if (!functions || (num_names != 0 && (!names || !ordinals))) {
+            return;
+        }
+
+        if (const auto* const module_name = img.template rva_to_ptr<char>(export_dir->name())) {
+            name_ = module_name;
+        }
+
+        base_ = export_dir->base();
+
+        const auto dir_begin = data_directory->rva();
+        const auto dir_end   = dir_begin + data_directory->size();
+
+        functions_.resize(num_functions);
+
+        for (u32 i{}; i < num_functions; ++i) {
+            auto& entry = functions_[i];
+
+            entry.rva = bit::load_little<u32>(functions + i * sizeof(u32));
+
+            if (entry.rva >= dir_begin && entry.rva < dir_end) {
+                if (const auto* const forward = img.template rva_to_ptr<char>(entry.rva)) {
+                    entry.forward = forward;
+                }
+            }
+        }
+
+        names_.reserve(num_names);
+        name_ordinals_.reserve(num_names);
+
+        for (u32 i{}; i < num_names; ++i) {
+            const auto* const name = img.template rva_to_ptr<char>(bit::load_little<u32>(names + i * sizeof(u32)));
+
+            names_.emplace_back(name ? name : "");
+            name_ordinals_.push_back(bit::load_little<u16>(ordinals + i * sizeof(u16)));
+        }
+
+        if (!std::is_sorted(names_.begin(), names_.end())) {
+            order_.resize(num_names);
+
+            for (u32 i{}; i < num_names; ++i) {
+                order_[i] = i;
+            }
+
+            std::sort(order_.begin(), order_.end(), [this](const u32 lhs, const u32 rhs) {
+                return names_[lhs] < names_[rhs];
+            });
+        }
+    }
+
+    NODISCARD
+    auto
+    valid() const noexcept -> bool
+    {
+        return !functions_.empty();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    name() const noexcept -> std::string_view
+    {
+        return name_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    base() const noexcept -> u32
+    {
+        return base_;
+    }
+
+    NODISCARD
+    auto
+    num_functions() const noexcept -> szt
+    {
+        return functions_.size();
+    }
+
+    NODISCARD
+    auto
+    num_names() const noexcept -> szt
+    {
+        return names_.size();
+    }
+
+    NODISCARD
+    auto
+    name_at(
+        const szt index
+    ) const noexcept -> std::string_view
+    {
+        return index < names_.size() ? names_[index] : std::string_view{};
+    }
+
+    // Returns the name pointer table slot of `name`, or num_names() if it isn't exported.
+    NODISCARD
+    auto
+    find_slot(
+        const std::string_view name
+    ) const noexcept -> szt
+    {
+        if (order_.empty()) {
+            const auto it = std::lower_bound(names_.begin(), names_.end(), name);
+
+            return it != names_.end() && *it == name
+                ? static_cast<szt>(it - names_.begin())
+                : names_.size();
+        }
+
+        const auto it = std::lower_bound(order_.begin(), order_.end(), name, [this](const u32 slot, const std::string_view value) {
+            return names_[slot] < value;
+        });
+
+        return it != order_.end() && names_[*it] == name
+            ? *it
+            : names_.size();
+    }
+
+    NODISCARD
+    auto
+    find(
+        const std::string_view name
+    ) const noexcept -> const export_entry*
+    {
+        const auto slot = find_slot(name);
+
+        return slot < names_.size() ? at_index(name_ordinals_[slot]) : nullptr;
+    }
+
+    // Import hints are indexes into the name pointer table, so a hint from a matching build of the
+    // exporter resolves with a single compare. Stale hints fall back to find(name).
+    NODISCARD
+    auto
+    find(
+        const std::string_view name,
+        const u16              hint,
+        bool&                  hint_hit
+    ) const noexcept -> const export_entry*
+    {
+        hint_hit = hint < names_.size() && names_[hint] == name;
+
+        return hint_hit ? at_index(name_ordinals_[hint]) : find(name);
+    }
+
+    NODISCARD
+    auto
+    find(
+        const std::string_view name,
+        const u16              hint
+    ) const noexcept -> const export_entry*
+    {
+        bool hint_hit{};
+
+        return find(name, hint, hint_hit);
+    }
+
+    // Looks up a biased ordinal, i.e. the value stored in an import thunk.
+    NODISCARD
+    auto
+    find(
+        const u16 ordinal
+    ) const noexcept -> const export_entry*
+    {
+        return ordinal >= base_ ? at_index(ordinal - base_) : nullptr;
+    }
+
+    // Looks up an unbiased index into the export address table.
+    NODISCARD
+    auto
+    at_index(
+        const szt index
+    ) const noexcept -> const export_entry*
+    {
+        if (index >= functions_.size() || functions_[index].rva == 0) {
+            return nullptr;
+        }
+
+        return &functions_[index];
+    }
+
+    NODISCARD
+    auto
+    name_ordinal(
+        const szt slot
+    ) const noexcept -> u16
+    {
+        return slot < name_ordinals_.size() ? name_ordinals_[slot] : 0;
+    }
+
+private:
+    std::string_view              name_{};
+    u32                           base_{};
+    std::vector<export_entry>     functions_;
+    std::vector<std::string_view> names_;
+    std::vector<u16>              name_ordinals_;
+    std::vector<u32>              order_;
+};
+} //namespace zen::win
@@ -0,0 +1,705 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/cpu.hpp>
+#include <zen/nt/image.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#if defined(ZEN_TARGET_X86)
+#   include <immintrin.h>
+#endif
+
+namespace zen::detail {
+// Every position of the 5 byte window c0..c4 (c0 being the newest byte) feeds six triplets into
+// 128 buckets, as TLSH does. The triplets are hashed multiplicatively instead of through a
+// Pearson table so that the kernels can evaluate eight positions at once; each triplet counts
+// into its own table to keep the increments independent.
+constexpr u32 fuzzy_triplets[6][3]{
+    {1, 2, 2}, {1, 3, 3}, {2, 3, 5}, {2, 4, 7}, {1, 4, 11}, {3, 4, 13},
+};
+
+using fuzzy_counts = u32[6][128];
+
+NODISCARD
+constexpr
+auto
+fuzzy_bucket(
+    const u32 c0,
+    const u32 a,
+    const u32 b,
+    const u32 salt
+) noexcept -> u32
+{
+    return ((c0 | a << 8 | b << 16 | salt << 24) * 0x9E3779B1u) >> 25;
+}
+
+NODISCARD
+constexpr
+auto
+fuzzy_pair(
+    const u32 c0,
+    const u32 c1
+) noexcept -> u32
+{
+    return ((c0 | c1 << 8) * 0x9E3779B1u) >> 24;
+}
+
+// Positions [begin, size) of data, every position needs the four bytes in front of it.
+inline
+auto
+fuzzy_update_scalar(
+    const u8* const data,
+    szt             begin,
+    const szt       size,
+    fuzzy_counts&   counts
+) noexcept -> u32
+{
+    u32 checksum{};
+
+    for (; begin < size; ++begin) {
+        const u32 window[5]{data[begin], data[begin - 1], data[begin - 2], data[begin - 3], data[begin - 4]};
+
+        for (szt t{}; t < 6; ++t) {
+            const auto& triplet = fuzzy_triplets[t];
+
+            ++counts[t][fuzzy_bucket(window[0], window[triplet[0]], window[triplet[1]], triplet[2])];
+        }
+
+        checksum += fuzzy_pair(window[0], window[1]);
+    }
+
+    return checksum;
+}
+
+#if defined(ZEN_TARGET_X86)
+ZEN_TARGET_FEATURES("avx2")
+inline
+auto
+fuzzy_update_avx2(
+    const u8* const data,
+    szt             begin,
+    const szt       size,
+    fuzzy_counts&   counts
+) noexcept -> u32
+{
+    const auto golden = _mm256_set1_epi32(static_cast<int>(0x9E3779B1u));
+    auto       sum    = _mm256_setzero_si256();
+
+    alignas(32) u32 buckets[6][8];
+
+    for (; begin + 8 <= size; begin += 8) {
+        __m256i window[5];
+
+        for (szt i{}; i < 5; ++i) {
+            window[i] = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(data + begin - i)));
+        }
+
+        for (szt t{}; t < 6; ++t) {
+            const auto& triplet = fuzzy_triplets[t];
+
+            auto key = _mm256_or_si256(window[0], _mm256_slli_epi32(window[triplet[0]], 8));
+
+            key = _mm256_or_si256(key, _mm256_slli_epi32(window[triplet[1]], 16));
+            key = _mm256_or_si256(key, _mm256_set1_epi32(static_cast<int>(triplet[2] << 24)));
+
+            _mm256_store_si256(
+                reinterpret_cast<__m256i*>(buckets[t]),
+                _mm256_srli_epi32(_mm256_mullo_epi32(key, golden), 25)
+            );
+        }
+
+        const auto pair = _mm256_or_si256(window[0], _mm256_slli_epi32(window[1], 8));
+
+        sum = _mm256_add_epi32(sum, _mm256_srli_epi32(_mm256_mullo_epi32(pair, golden), 24));
+
+        for (szt i{}; i < 8; ++i) {
+            ++counts[0][buckets[0][i]];
+            ++counts[1][buckets[1][i]];
+            ++counts[2][buckets[2][i]];
+            ++counts[3][buckets[3][i]];
+            ++counts[4][buckets[4][i]];
+            ++counts[5][buckets[5][i]];
+        }
+    }
+
+    alignas(32) u32 lanes[8];
+
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+
+    u32 checksum{};
+
+    for (const auto lane : lanes) {
+        checksum += lane;
+    }
+
+    return checksum + fuzzy_update_scalar(data, begin, size, counts);
+}
+
+// Bodies are 32 bytes of 2-bit codes, the code distance |x - y| (6 for 0 vs 3) is looked up for
+// each of the four code pairs of a byte with a single shuffle.
+ZEN_TARGET_FEATURES("avx2")
+inline
+auto
+fuzzy_body_distance_avx2(
+    const u8* const lhs,
+    const u8* const rhs
+) noexcept -> u32
+{
+    const auto table = _mm256_setr_epi8(
+        0, 1, 2, 6, 1, 0, 1, 2, 2, 1, 0, 1, 6, 2, 1, 0,
+        0, 1, 2, 6, 1, 0, 1, 2, 2, 1, 0, 1, 6, 2, 1, 0
+    );
+    const auto mask = _mm256_set1_epi8(3);
+    const auto a    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs));
+    const auto b    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs));
+
+    auto acc = _mm256_setzero_si256();
+
+    for (int shift{}; shift < 8; shift += 2) {
+        const auto x = _mm256_and_si256(_mm256_srl_epi16(a, _mm_cvtsi32_si128(shift)), mask);
+        const auto y = _mm256_and_si256(_mm256_srl_epi16(b, _mm_cvtsi32_si128(shift)), mask);
+
+        acc = _mm256_add_epi8(acc, _mm256_shuffle_epi8(table, _mm256_or_si256(_mm256_slli_epi16(x, 2), y)));
+    }
+
+    const auto sums   = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+    const auto halves = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    const auto total  = _mm_add_epi64(halves, _mm_unpackhi_epi64(halves, halves));
+
+    // at most 6 * 256, the low 32 bits hold all of it
+    return static_cast<u32>(_mm_cvtsi128_si32(total));
+}
+
+// Per-lane byte sums of the code distances between the prepared query `planes` (the codes of
+// each shift, moved up by two bits) and `body`.
+ZEN_TARGET_FEATURES("avx2")
+inline
+auto
+fuzzy_body_sums_avx2(
+    const __m256i (&planes)[4],
+    const u8* const body
+) noexcept -> __m256i
+{
+    const auto table = _mm256_setr_epi8(
+        0, 1, 2, 6, 1, 0, 1, 2, 2, 1, 0, 1, 6, 2, 1, 0,
+        0, 1, 2, 6, 1, 0, 1, 2, 2, 1, 0, 1, 6, 2, 1, 0
+    );
+    const auto mask = _mm256_set1_epi8(3);
+    const auto b    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(body));
+
+    auto acc = _mm256_setzero_si256();
+
+    for (int k{}; k < 4; ++k) {
+        const auto y = _mm256_and_si256(_mm256_srl_epi16(b, _mm_cvtsi32_si128(k * 2)), mask);
+
+        acc = _mm256_add_epi8(acc, _mm256_shuffle_epi8(table, _mm256_or_si256(planes[k], y)));
+    }
+
+    return _mm256_sad_epu8(acc, _mm256_setzero_si256());
+}
+#endif
+
+NODISCARD
+inline
+auto
+fuzzy_body_distance_scalar(
+    const u8* const lhs,
+    const u8* const rhs
+) noexcept -> u32
+{
+    u32 result{};
+
+    for (szt i{}; i < 32; ++i) {
+        for (int shift{}; shift < 8; shift += 2) {
+            const auto x    = (lhs[i] >> shift) & 3;
+            const auto y    = (rhs[i] >> shift) & 3;
+            const auto diff = x > y ? x - y : y - x;
+
+            result += diff == 3 ? 6 : diff;
+        }
+    }
+
+    return result;
+}
+
+NODISCARD
+constexpr
+auto
+fuzzy_mod_diff(
+    const u32 x,
+    const u32 y,
+    const u32 range
+) noexcept -> u32
+{
+    const auto diff = x > y ? x - y : y - x;
+
+    return std::min(diff, range - diff);
+}
+} //namespace zen::detail
+
+namespace zen::win {
+// TLSH-style locality sensitive hash: one checksum byte, the log length, two quartile ratios and
+// a 2-bit code for each of 128 buckets. The layout and distance follow TLSH, the bucket mapping
+// doesn't, so values are only comparable with other zen fuzzy hashes.
+struct fuzzy_hash
+{
+    u8                 checksum{};
+    u8                 lvalue{};
+    u8                 q1_ratio{};
+    u8                 q2_ratio{};
+    std::array<u8, 32> body{};
+    bool               valid{};
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid;
+    }
+};
+
+// Accumulates the bucket counts over any number of chunks, a window spanning two chunks is
+// handled through the last four bytes of the previous one.
+class fuzzy_hasher
+{
+public:
+    constexpr static szt min_length = 50;
+
+    auto
+    update(
+        const std::span<const u8> data
+    ) noexcept -> fuzzy_hasher&
+    {
+        const auto* const bytes = data.data();
+        const auto        size  = data.size();
+        szt               i{};
+
+        // positions whose window reaches back into the previous chunks
+        for (; i < size && i < 4; ++i) {
+            shift_in(bytes[i]);
+        }
+
+        if (size > 4) {
+#if defined(ZEN_TARGET_X86)
+            static const auto accelerated = cpu().avx2;
+
+            checksum_ += accelerated
+                ? detail::fuzzy_update_avx2(bytes, 4, size, counts_)
+                : detail::fuzzy_update_scalar(bytes, 4, size, counts_);
+#else
+            checksum_ += detail::fuzzy_update_scalar(bytes, 4, size, counts_);
+#endif
+
+            seen_   += size - 4;
+            length_ += size - 4;
+
+            for (szt k{}; k < 4; ++k) {
+                tail_[k] = bytes[size - 1 - k];
+            }
+        }
+
+        return *this;
+    }
+
+    // Returns an invalid hash for less than min_length bytes or data too uniform to be ranked.
+    NODISCARD
+    auto
+    finalize() const noexcept -> fuzzy_hash
+    {
+        fuzzy_hash result;
+
+        if (seen_ < min_length || length_ == 0) {
+            return result;
+        }
+
+        std::array<u32, 128> buckets{};
+
+        for (szt b{}; b < 128; ++b) {
+            for (szt t{}; t < 6; ++t) {
+                buckets[b] += counts_[t][b];
+            }
+        }
+
+        auto sorted = buckets;
+
+        std::nth_element(sorted.begin(), sorted.begin() + 31, sorted.end());
+        const auto q1 = sorted[31];
+        std::nth_element(sorted.begin() + 32, sorted.begin() + 63, sorted.end());
+        const auto q2 = sorted[63];
+        std::nth_element(sorted.begin() + 64, sorted.begin() + 95, sorted.end());
+        const auto q3 = sorted[95];
+
+        if (q3 == 0) {
+            return result;
+        }
+
+        for (szt b{}; b < 128; ++b) {
+            const auto count = buckets[b];
+            const auto code  = count <= q1 ? 0 : count <= q2 ? 1 : count <= q3 ? 2 : 3;
+
+            result.body[b / 4] |= static_cast<u8>(code << ((b % 4) * 2));
+        }
+
+        result.checksum = static_cast<u8>(checksum_);
+        result.lvalue   = log_length(seen_);
+        result.q1_ratio = static_cast<u8>(static_cast<u64>(q1) * 100 / q3 % 16);
+        result.q2_ratio = static_cast<u8>(static_cast<u64>(q2) * 100 / q3 % 16);
+        result.valid    = true;
+
+        return result;
+    }
+
+    NODISCARD
+    static
+    auto
+    hash(
+        const std::span<const u8> data
+    ) noexcept -> fuzzy_hash
+    {
+        fuzzy_hasher hasher;
+
+        return hasher.update(data).finalize();
+    }
+
+private:
+    auto
+    shift_in(
+        const u8 value
+    ) noexcept -> void
+    {
+        if (seen_ >= 4) {
+            for (szt t{}; t < 6; ++t) {
+                const auto& triplet = detail::fuzzy_triplets[t];
+                const u32   window[5]{value, tail_[0], tail_[1], tail_[2], tail_[3]};
+
+                ++counts_[t][detail::fuzzy_bucket(window[0], window[triplet[0]], window[triplet[1]], triplet[2])];
+            }
+
+            checksum_ += detail::fuzzy_pair(value, tail_[0]);
+            ++length_;
+        }
+
+        tail_[3] = tail_[2];
+        tail_[2] = tail_[1];
+        tail_[1] = tail_[0];
+        tail_[0] = value;
+
+        ++seen_;
+    }
+
+    NODISCARD
+    static
+    auto
+    log_length(
+        const u64 length
+    ) noexcept -> u8
+    {
+        const auto value = static_cast<double>(length);
+
+        if (length <= 656) {
+            return static_cast<u8>(static_cast<u64>(std::log(value) / std::log(1.5)) % 256);
+        }
+
+        if (length <= 3199) {
+            return static_cast<u8>(static_cast<u64>(std::log(value) / std::log(1.3) - 8.72777) % 256);
+        }
+
+        return static_cast<u8>(static_cast<u64>(std::log(value) / std::log(1.1) - 62.5472) % 256);
+    }
+
+    detail::fuzzy_counts counts_{};
+    u8                   tail_[4]{};
+    u64                  seen_{};
+    u64                  length_{};
+    u32                  checksum_{};
+};
+} //namespace zen::win
+
+namespace zen::detail {
+// Distance of everything in front of the body.
+NODISCARD
+inline
+auto
+fuzzy_header_distance(
+    const win::fuzzy_hash& lhs,
+    const win::fuzzy_hash& rhs
+) noexcept -> u32
+{
+    const auto ldiff  = fuzzy_mod_diff(lhs.lvalue, rhs.lvalue, 256);
+    const auto q1diff = fuzzy_mod_diff(lhs.q1_ratio, rhs.q1_ratio, 16);
+    const auto q2diff = fuzzy_mod_diff(lhs.q2_ratio, rhs.q2_ratio, 16);
+
+    return static_cast<u32>(lhs.checksum != rhs.checksum)
+        + (ldiff <= 1 ? ldiff : ldiff * 12)
+        + (q1diff <= 1 ? q1diff : (q1diff - 1) * 12)
+        + (q2diff <= 1 ? q2diff : (q2diff - 1) * 12);
+}
+
+#if defined(ZEN_TARGET_X86)
+// fuzzy_mod_diff on eight u32 lanes.
+ZEN_TARGET_FEATURES("avx2")
+inline
+auto
+fuzzy_mod_diff_avx2(
+    const __m256i x,
+    const __m256i y,
+    const int     range
+) noexcept -> __m256i
+{
+    const auto diff = _mm256_abs_epi32(_mm256_sub_epi32(x, y));
+
+    return _mm256_min_epu32(diff, _mm256_sub_epi32(_mm256_set1_epi32(range), diff));
+}
+
+// Byte `shift / 8` of every u32 lane.
+ZEN_TARGET_FEATURES("avx2")
+inline
+auto
+fuzzy_field_avx2(
+    const __m256i v,
+    const int     shift
+) noexcept -> __m256i
+{
+    return _mm256_and_si256(_mm256_srl_epi32(v, _mm_cvtsi32_si128(shift)), _mm256_set1_epi32(0xFF));
+}
+
+// `diff <= 1 ? diff : scaled` per lane.
+ZEN_TARGET_FEATURES("avx2")
+inline
+auto
+fuzzy_penalty_avx2(
+    const __m256i diff,
+    const __m256i scaled
+) noexcept -> __m256i
+{
+    return _mm256_blendv_epi8(scaled, diff, _mm256_cmpgt_epi32(_mm256_set1_epi32(2), diff));
+}
+
+// Adds up four fuzzy_body_sums_avx2 results into four u32 lanes.
+ZEN_TARGET_FEATURES("avx2")
+inline
+auto
+fuzzy_reduce4_avx2(
+    const __m256i s0,
+    const __m256i s1,
+    const __m256i s2,
+    const __m256i s3
+) noexcept -> __m128i
+{
+    // every sum fits 32 bits, pair them up in the halves of the 64-bit lanes
+    const auto s01 = _mm256_or_si256(s0, _mm256_slli_epi64(s1, 32));
+    const auto s23 = _mm256_or_si256(s2, _mm256_slli_epi64(s3, 32));
+    const auto l01 = _mm_add_epi64(_mm256_castsi256_si128(s01), _mm256_extracti128_si256(s01, 1));
+    const auto l23 = _mm_add_epi64(_mm256_castsi256_si128(s23), _mm256_extracti128_si256(s23, 1));
+
+    return _mm_add_epi64(_mm_unpacklo_epi64(l01, l23), _mm_unpackhi_epi64(l01, l23));
+}
+
+// Distances of `query` to the hashes of `set` eight at a time, the query is split into its
+// fields and shifted body codes once. The four header bytes of eight hashes sit in the u32 lanes
+// of one vector, the bodies go through the shuffle lookup four per reduction. Returns how many
+// hashes were done, the rest of `set` is left to the caller.
+ZEN_TARGET_FEATURES("avx2")
+inline
+auto
+fuzzy_distance_batch_avx2(
+    const win::fuzzy_hash&                 query,
+    const std::span<const win::fuzzy_hash> set,
+    u32* const                             out
+) noexcept -> szt
+{
+    const auto mask   = _mm256_set1_epi8(3);
+    const auto one    = _mm256_set1_epi32(1);
+    const auto twelve = _mm256_set1_epi32(12);
+    const auto body   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(query.body.data()));
+
+    __m256i planes[4];
+
+    for (int k{}; k < 4; ++k) {
+        planes[k] = _mm256_slli_epi16(_mm256_and_si256(_mm256_srl_epi16(body, _mm_cvtsi32_si128(k * 2)), mask), 2);
+    }
+
+    const auto header = [](const win::fuzzy_hash& hash) {
+        return static_cast<int>(hash.checksum | hash.lvalue << 8 | hash.q1_ratio << 16 | static_cast<u32>(hash.q2_ratio) << 24);
+    };
+
+    const auto q = _mm256_set1_epi32(header(query));
+
+    szt i{};
+
+    for (; i + 8 <= set.size(); i += 8) {
+        const auto* const h = set.data() + i;
+
+        const auto v = _mm256_setr_epi32(
+            header(h[0]), header(h[1]), header(h[2]), header(h[3]),
+            header(h[4]), header(h[5]), header(h[6]), header(h[7])
+        );
+        const auto valid = _mm256_setr_epi32(
+            h[0].valid, h[1].valid, h[2].valid, h[3].valid,
+            h[4].valid, h[5].valid, h[6].valid, h[7].valid
+        );
+
+        const auto ldiff  = fuzzy_mod_diff_avx2(fuzzy_field_avx2(v, 8), fuzzy_field_avx2(q, 8), 256);
+        const auto q1diff = fuzzy_mod_diff_avx2(fuzzy_field_avx2(v, 16), fuzzy_field_avx2(q, 16), 16);
+        const auto q2diff = fuzzy_mod_diff_avx2(fuzzy_field_avx2(v, 24), fuzzy_field_avx2(q, 24), 16);
+
+        auto total = _mm256_andnot_si256(_mm256_cmpeq_epi32(fuzzy_field_avx2(v, 0), fuzzy_field_avx2(q, 0)), one);
+
+        total = _mm256_add_epi32(total, fuzzy_penalty_avx2(ldiff, _mm256_mullo_epi32(ldiff, twelve)));
+        total = _mm256_add_epi32(total, fuzzy_penalty_avx2(q1diff, _mm256_mullo_epi32(_mm256_sub_epi32(q1diff, one), twelve)));
+        total = _mm256_add_epi32(total, fuzzy_penalty_avx2(q2diff, _mm256_mullo_epi32(_mm256_sub_epi32(q2diff, one), twelve)));
+
+        const auto lo = fuzzy_reduce4_avx2(
+            fuzzy_body_sums_avx2(planes, h[0].body.data()), fuzzy_body_sums_avx2(planes, h[1].body.data()),
+            fuzzy_body_sums_avx2(planes, h[2].body.data()), fuzzy_body_sums_avx2(planes, h[3].body.data())
+        );
+        const auto hi = fuzzy_reduce4_avx2(
+            fuzzy_body_sums_avx2(planes, h[4].body.data()), fuzzy_body_sums_avx2(planes, h[5].body.data()),
+            fuzzy_body_sums_avx2(planes, h[6].body.data()), fuzzy_body_sums_avx2(planes, h[7].body.data())
+        );
+
+        total = _mm256_add_epi32(total, _mm256_set_m128i(hi, lo));
+
+        // invalid hashes end up as ~0u
+        total = _mm256_or_si256(total, _mm256_cmpeq_epi32(valid, _mm256_setzero_si256()));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), total);
+    }
+
+    return i;
+}
+#endif
+} //namespace zen::detail
+
+namespace zen::win {
+// TLSH distance, 0 for identical input and growing with the difference. Invalid hashes compare
+// as far apart as possible.
+NODISCARD
+inline
+auto
+distance(
+    const fuzzy_hash& lhs,
+    const fuzzy_hash& rhs
+) noexcept -> u32
+{
+    if (!lhs.valid || !rhs.valid) {
+        return ~0u;
+    }
+
+    const auto result = detail::fuzzy_header_distance(lhs, rhs);
+
+#if defined(ZEN_TARGET_X86)
+    static const auto accelerated = cpu().avx2;
+
+    if (accelerated) {
+        return result + detail::fuzzy_body_distance_avx2(lhs.body.data(), rhs.body.data());
+    }
+#endif
+
+    return result + detail::fuzzy_body_distance_scalar(lhs.body.data(), rhs.body.data());
+}
+
+// Distance of `query` to every hash of `set`, `out` has to hold set.size() entries. With AVX2
+// eight hashes are compared per pass against a query prepared once.
+inline
+auto
+distance(
+    const fuzzy_hash&                 query,
+    const std::span<const fuzzy_hash> set,
+    const std::span<u32>              out
+) noexcept -> void
+{
+    const auto count = std::min(set.size(), out.size());
+
+    if (!query.valid) {
+        std::fill_n(out.begin(), count, ~0u);
+        return;
+    }
+
+    szt done{};
+
+#if defined(ZEN_TARGET_X86)
+    static const auto accelerated = cpu().avx2;
+
+    if (accelerated) {
+        done = detail::fuzzy_distance_batch_avx2(query, set.first(count), out.data());
+    }
+#endif
+
+    for (auto i = done; i < count; ++i) {
+        out[i] = distance(query, set[i]);
+    }
+}
+
+struct image_fuzzy_hashes
+{
+    fuzzy_hash code;
+    fuzzy_hash data;
+    fuzzy_hash resources;
+};
+
+// Hashes the raw data of the code sections, the resource section and every other section
+// separately, reading straight from the file mapped image. Raw data past `file_size` is ignored.
+template<bool X64 = detail::is_64_bit>
+NODISCARD
+auto
+fuzzy_hashes(
+    const image<X64>& img,
+    const szt         file_size
+) noexcept -> image_fuzzy_hashes
+{
+    const auto* const nt        = img.nt_hdr();
+    const auto* const base      = reinterpret_cast<const u8*>(&img);
+    const auto* const resources = img.directory(win::directory::resource);
+
+    fuzzy_hasher code;
+    fuzzy_hasher data;
+    fuzzy_hasher rsrc;
+
+    for (szt i{}; i < nt->file_hdr().num_sections(); ++i) {
+        const auto* const scn   = nt->section(i);
+        const auto        begin = std::min<szt>(scn->ptr_raw_data(), file_size);
+        const auto        end   = std::min<szt>(begin + scn->size_raw_data(), file_size);
+        const auto        flags = scn->characteristics();
+
+        const auto holds_resources = resources
+            && scn->virtual_address() <= resources->rva()
+            && resources->rva() < scn->virtual_address() + std::max(scn->virtual_size(), scn->size_raw_data());
+
+        auto& hasher = holds_resources
+            ? rsrc
+            : flags.cnt_code || flags.mem_execute ? code : data;
+
+        hasher.update({base + begin, end - begin});
+    }
+
+    return {code.finalize(), data.finalize(), rsrc.finalize()};
+}
+} //namespace zen::win
@@ -39,8 +39,15 @@
 
 #if defined(ZEN_IMAGE_RELOC_INFO_COLLECTION)
 #   include <zen/nt/directories/relocs.hpp>
+#   include <vector>
 #endif //ZEN_IMAGE_RELOC_INFO_COLLECTION
 
+#if defined(ZEN_IMAGE_SECTION_STATS_COLLECTION)
+#   include <zen/core/parallel.hpp>
+#   include <zen/nt/section_stats.hpp>
+#   include <vector>
+#endif //ZEN_IMAGE_SECTION_STATS_COLLECTION
+
 ZEN_WIN32_ALIGNMENT(zen::win)
 #if defined(ZEN_IMAGE_IMPORT_INFO_COLLECTION)
 struct import_info
@@ -579,6 +586,36 @@ public:
     }
 #endif //ZEN_IMAGE_RELOC_INFO_COLLECTION
 
+#if defined(ZEN_IMAGE_SECTION_STATS_COLLECTION)
+    // One entry per section header of the file mapped image, raw data past `file_size` is cut
+    // off. Sections are spread over up to `threads` workers.
+    NODISCARD
+    auto
+    collect_section_stats(
+        const szt               file_size,
+        const section_analyzer& analyzer = section_analyzer{},
+        const u32               threads  = 0
+    ) const -> std::vector<section_stats>
+    {
+        const auto* const nt   = nt_hdr();
+        const auto* const base = reinterpret_cast<const u8*>(this);
+
+        std::vector<section_stats> result(nt->file_hdr().num_sections());
+
+        parallel_for(result.size(), [&](const szt i) {
+            const auto* const scn   = nt->section(i);
+            const auto        begin = std::min<szt>(scn->ptr_raw_data(), file_size);
+            const auto        end   = std::min<szt>(begin + scn->size_raw_data(), file_size);
+
+            result[i].section = scn;
+
+            analyzer.analyze({base + begin, end - begin}, result[i]);
+        }, threads);
+
+        return result;
+    }
+#endif //ZEN_IMAGE_SECTION_STATS_COLLECTION
+
     NODISCARD
     ZEN_CXX23_CONSTEXPR
     static
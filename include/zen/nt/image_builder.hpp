@@ -0,0 +1,551 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/nt/checksum.hpp>
+#include <zen/nt/image.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace zen::win {
+// Serialises a PE from headers, section contents and trailing data as a list of byte ranges that
+// written back to back form the file. Section contents are views, typically into the mapped
+// image the builder was created from, so only the headers and padding are materialised and an
+// unchanged section is never copied. build() recomputes the layout dependent header fields
+// (file offsets, raw sizes, size_image, size_headers and the checksum); the
+// segments are then handed to a gather write such as posix::write_segments.
+template<bool X64 = detail::is_64_bit>
+class image_builder
+{
+    struct section_entry
+    {
+        coff::section_header header;
+        std::span<const u8>  data;
+    };
+
+public:
+    image_builder() noexcept
+    {
+        dos_.magic(dos_header::magic_value);
+
+        nt_.signature(nt_headers<X64>::magic_value);
+        nt_.file_hdr().machine(X64 ? coff::machine_id::amd64 : coff::machine_id::i386);
+        nt_.optional_hdr().magic(X64 ? optional_header_base::magic_value_64_bit : optional_header_base::magic_value_32_bit);
+        nt_.optional_hdr().section_alignment(0x1000);
+        nt_.optional_hdr().file_alignment(0x200);
+        nt_.optional_hdr().num_data_directories(16);
+    }
+
+    // Takes over the headers, DOS stub, sections, overlay and certificate table of the file layout
+    // image in `file`. Returns an invalid builder if the headers or section table are out of bounds.
+    NODISCARD
+    static
+    auto
+    from_image(
+        const std::span<const u8> file
+    ) -> image_builder
+    {
+        image_builder builder;
+
+        builder.valid_ = false;
+
+        if (file.size() < sizeof(dos_header)) {
+            return builder;
+        }
+
+        const auto* const img    = reinterpret_cast<const image<X64>*>(file.data());
+        const auto        nt_ptr = static_cast<szt>(img->dos_hdr()->next_hdr_offset());
+
+        if (!img->dos_hdr()->valid()
+            || nt_ptr < sizeof(dos_header)
+            || nt_ptr > file.size()
+            || file.size() - nt_ptr < sizeof(u32) + sizeof(coff::file_header)
+        ) {
+            return builder;
+        }
+
+        const auto* const nt       = img->nt_hdr();
+        const auto        opt_size = std::min<szt>(nt->file_hdr().size_optional_header(), sizeof(optional_header<X64>));
+        const auto        table    = nt_ptr + sizeof(u32) + sizeof(coff::file_header) + nt->file_hdr().size_optional_header();
+        const auto        count    = nt->file_hdr().num_sections();
+
+        if (!nt->valid()
+            || nt->is_64_bit() != X64
+            || table > file.size()
+            || (file.size() - table) / sizeof(coff::section_header) < count
+        ) {
+            return builder;
+        }
+
+        builder.dos_ = *img->dos_hdr();
+        builder.stub_.assign(file.begin() + sizeof(dos_header), file.begin() + static_cast<std::ptrdiff_t>(nt_ptr));
+
+        std::memcpy(&builder.nt_, nt, sizeof(u32) + sizeof(coff::file_header) + opt_size);
+
+        auto&             opt     = builder.nt_.optional_hdr();
+        const auto* const scn     = reinterpret_cast<const coff::section_header*>(file.data() + table);
+        szt               raw_end = opt.size_headers();
+
+        for (szt i{}; i < count; ++i) {
+            const auto begin = std::min<szt>(scn[i].ptr_raw_data(), file.size());
+            const auto size  = std::min<szt>(scn[i].size_raw_data(), file.size() - begin);
+
+            builder.sections_.push_back({scn[i], file.subspan(begin, size)});
+
+            raw_end = std::max(raw_end, begin + size);
+        }
+
+        auto& security = opt.data_directories().at(win::directory::security);
+        auto  overlay  = file.subspan(std::min(raw_end, file.size()));
+
+        if (security.present() && security.rva() >= raw_end && security.rva() <= file.size()) {
+            const auto offset = static_cast<szt>(security.rva());
+
+            builder.certificates_ = file.subspan(offset, std::min<szt>(security.size(), file.size() - offset));
+
+            overlay = overlay.first(offset - raw_end);
+        }
+
+        // a bound import table usually sits behind the section headers, which get rewritten
+        if (opt.data_directories().at(win::directory::bound_import).rva() < opt.size_headers()) {
+            opt.data_directories().at(win::directory::bound_import).rva(0);
+            opt.data_directories().at(win::directory::bound_import).size(0);
+        }
+
+        builder.overlay_ = overlay;
+        builder.valid_   = true;
+
+        return builder;
+    }
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return valid_;
+    }
+
+    NODISCARD
+    auto
+    dos_hdr() noexcept -> dos_header&
+    {
+        return dos_;
+    }
+
+    NODISCARD
+    auto
+    nt_hdr() noexcept -> nt_headers<X64>&
+    {
+        return nt_;
+    }
+
+    NODISCARD
+    auto
+    nt_hdr() const noexcept -> const nt_headers<X64>&
+    {
+        return nt_;
+    }
+
+    // Bytes between the DOS header and the NT headers, the Rich header included.
+    auto
+    dos_stub(
+        const std::span<const u8> stub
+    ) -> image_builder&
+    {
+        stub_.assign(stub.begin(), stub.end());
+
+        return *this;
+    }
+
+    NODISCARD
+    auto
+    directory(
+        const win::directory id
+    ) noexcept -> data_directory&
+    {
+        return nt_.optional_hdr().data_directories().at(id);
+    }
+
+    NODISCARD
+    auto
+    num_sections() const noexcept -> szt
+    {
+        return sections_.size();
+    }
+
+    NODISCARD
+    auto
+    section(
+        const szt index
+    ) noexcept -> coff::section_header&
+    {
+        return sections_[index].header;
+    }
+
+    NODISCARD
+    auto
+    section_data(
+        const szt index
+    ) const noexcept -> std::span<const u8>
+    {
+        return sections_[index].data;
+    }
+
+    // The bytes have to stay alive until the segments are written.
+    auto
+    section_data(
+        const szt                 index,
+        const std::span<const u8> data
+    ) noexcept -> image_builder&
+    {
+        sections_[index].data = data;
+
+        return *this;
+    }
+
+    // Appends a section. A zero virtual address places it after the last section, a zero virtual
+    // size takes the size of `data`.
+    auto
+    add_section(
+        coff::section_header      header,
+        const std::span<const u8> data
+    ) -> coff::section_header&
+    {
+        if (header.virtual_size() == 0) {
+            header.virtual_size(static_cast<u32>(data.size()));
+        }
+
+        if (header.virtual_address() == 0) {
+            header.virtual_address(next_rva());
+        }
+
+        sections_.push_back({header, data});
+
+        return sections_.back().header;
+    }
+
+    auto
+    remove_section(
+        const szt index
+    ) -> void
+    {
+        sections_.erase(sections_.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+
+    // First RVA past the last section, where a new section would go.
+    NODISCARD
+    auto
+    next_rva() const noexcept -> u32
+    {
+        const auto alignment = nt_.optional_hdr().section_alignment();
+        u32        end       = align_up(static_cast<u32>(header_bytes()), alignment);
+
+        for (const auto& s : sections_) {
+            end = std::max(end, align_up(s.header.virtual_address() + std::max(s.header.virtual_size(), s.header.size_raw_data()), alignment));
+        }
+
+        return end;
+    }
+
+    // Data appended after the last section, before the certificate table.
+    auto
+    overlay(
+        const std::span<const u8> data
+    ) noexcept -> image_builder&
+    {
+        overlay_ = data;
+
+        return *this;
+    }
+
+    // Certificate table (WIN_CERTIFICATE entries), placed 8-byte aligned at the end of the file.
+    auto
+    certificates(
+        const std::span<const u8> data
+    ) noexcept -> image_builder&
+    {
+        certificates_ = data;
+
+        return *this;
+    }
+
+    // Lays out the file and fills segments(). Fails for alignments that aren't powers of two, a
+    // file alignment above the section alignment, sections overlapping each other or the grown
+    // headers, and anything that doesn't fit 32-bit offsets.
+    NODISCARD
+    auto
+    build(
+        const bool checksum = true
+    ) -> bool
+    {
+        segments_.clear();
+        file_size_ = 0;
+
+        auto&      opt       = nt_.optional_hdr();
+        const auto file_algn = opt.file_alignment();
+        const auto scn_algn  = opt.section_alignment();
+
+        if (!valid_
+            || !std::has_single_bit(file_algn)
+            || !std::has_single_bit(scn_algn)
+            || file_algn > scn_algn
+            || sections_.size() > 0xFFFF
+        ) {
+            return false;
+        }
+
+        const auto headers = align_up(static_cast<u32>(header_bytes()), file_algn);
+
+        std::vector<const section_entry*> by_rva;
+
+        by_rva.reserve(sections_.size());
+
+        for (const auto& s : sections_) {
+            by_rva.push_back(&s);
+        }
+
+        std::sort(by_rva.begin(), by_rva.end(), [](const section_entry* lhs, const section_entry* rhs) {
+            return lhs->header.virtual_address() < rhs->header.virtual_address();
+        });
+
+        u64 rva_end = align_up(headers, scn_algn);
+
+        for (const auto* s : by_rva) {
+            if (s->header.virtual_address() < rva_end || s->header.virtual_address() % scn_algn != 0) {
+                return false;
+            }
+
+            rva_end = align_up64(static_cast<u64>(s->header.virtual_address()) + std::max<u64>(s->header.virtual_size(), 1), scn_algn);
+        }
+
+        if (rva_end > 0xFFFFFFFFull) {
+            return false;
+        }
+
+        nt_.file_hdr().num_sections(static_cast<u16>(sections_.size()));
+        nt_.file_hdr().size_optional_header(sizeof(optional_header<X64>));
+        opt.num_data_directories(16);
+        opt.size_headers(headers);
+        opt.size_image(static_cast<u32>(rva_end));
+        dos_.next_hdr_offset(static_cast<long_t>(sizeof(dos_header) + stub_.size()));
+
+        // file offsets follow the section order of the table
+        u64 offset = headers;
+
+        for (auto& s : sections_) {
+            const auto raw = align_up64(s.data.size(), file_algn);
+
+            s.header.ptr_raw_data(raw != 0 ? static_cast<u32>(offset) : 0);
+            s.header.size_raw_data(static_cast<u32>(raw));
+
+            offset += raw;
+        }
+
+        offset += overlay_.size();
+
+        auto& security = opt.data_directories().at(win::directory::security);
+
+        if (!certificates_.empty()) {
+            offset = align_up64(offset, 8);
+
+            security.rva(static_cast<u32>(offset));
+            security.size(static_cast<u32>(certificates_.size()));
+
+            offset += certificates_.size();
+        } else {
+            security.rva(0);
+            security.size(0);
+        }
+
+        if (offset > 0xFFFFFFFFull) {
+            return false;
+        }
+
+        opt.checksum(0);
+
+        // the headers are the only bytes the builder owns
+        header_.assign(headers, 0);
+
+        auto* out = header_.data();
+
+        std::memcpy(out, &dos_, sizeof(dos_));
+        out += sizeof(dos_);
+        std::memcpy(out, stub_.data(), stub_.size());
+        out += stub_.size();
+        std::memcpy(out, &nt_, sizeof(nt_));
+        out += sizeof(nt_);
+
+        for (const auto& s : sections_) {
+            std::memcpy(out, &s.header, sizeof(s.header));
+            out += sizeof(s.header);
+        }
+
+        segments_.push_back(header_);
+        file_size_ = headers;
+
+        for (const auto& s : sections_) {
+            if (!s.data.empty()) {
+                append(s.data);
+                pad(align_up64(file_size_, file_algn) - file_size_);
+            }
+        }
+
+        append(overlay_);
+
+        if (!certificates_.empty()) {
+            pad(align_up64(file_size_, 8) - file_size_);
+            append(certificates_);
+        }
+
+        if (checksum) {
+            pe_checksum sum{checksum_offset(header_)};
+
+            for (const auto& segment : segments_) {
+                sum.update(segment);
+            }
+
+            const auto value = bit::little(sum.finalize());
+
+            std::memcpy(header_.data() + checksum_offset(header_), &value, sizeof(value));
+        }
+
+        return true;
+    }
+
+    // Valid after build(), views into the builder and the section, overlay and certificate data.
+    NODISCARD
+    auto
+    segments() const noexcept -> std::span<const std::span<const u8>>
+    {
+        return segments_;
+    }
+
+    NODISCARD
+    auto
+    file_size() const noexcept -> szt
+    {
+        return file_size_;
+    }
+
+    // Copies the segments into one buffer, for callers that want the image in memory.
+    NODISCARD
+    auto
+    flatten() const -> std::vector<u8>
+    {
+        std::vector<u8> result;
+
+        result.reserve(file_size_);
+
+        for (const auto& segment : segments_) {
+            result.insert(result.end(), segment.begin(), segment.end());
+        }
+
+        return result;
+    }
+
+private:
+    NODISCARD
+    static
+    constexpr
+    auto
+    align_up(
+        const u32 value,
+        const u32 alignment
+    ) noexcept -> u32
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    NODISCARD
+    static
+    constexpr
+    auto
+    align_up64(
+        const u64 value,
+        const u64 alignment
+    ) noexcept -> u64
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    NODISCARD
+    auto
+    header_bytes() const noexcept -> szt
+    {
+        return sizeof(dos_header) + stub_.size() + sizeof(nt_headers<X64>) + sections_.size() * sizeof(coff::section_header);
+    }
+
+    auto
+    append(
+        const std::span<const u8> data
+    ) -> void
+    {
+        if (!data.empty()) {
+            segments_.push_back(data);
+            file_size_ += data.size();
+        }
+    }
+
+    auto
+    pad(
+        szt size
+    ) -> void
+    {
+        while (size != 0) {
+            const auto chunk = std::min(size, zeros.size());
+
+            append({zeros.data(), chunk});
+
+            size -= chunk;
+        }
+    }
+
+    constexpr static std::array<u8, 0x1000> zeros{};
+
+    dos_header                       dos_{};
+    std::vector<u8>                  stub_;
+    nt_headers<X64>                  nt_{};
+    std::vector<section_entry>       sections_;
+    std::span<const u8>              overlay_;
+    std::span<const u8>              certificates_;
+    std::vector<u8>                  header_;
+    std::vector<std::span<const u8>> segments_;
+    szt                              file_size_{};
+    bool                             valid_{true};
+};
+} //namespace zen::win
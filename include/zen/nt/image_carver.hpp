@@ -0,0 +1,358 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/cpu.hpp>
+#include <zen/nt/image.hpp>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+#if defined(ZEN_TARGET_X86)
+#   include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   include <arm_neon.h>
+#endif
+
+namespace zen::detail {
+// All kernels return the offset of the first "MZ" at or after `from`, or `size` if there is none.
+NODISCARD
+inline
+auto
+find_mz_scalar(
+    const u8* const data,
+    const szt       size,
+    szt             from
+) noexcept -> szt
+{
+    for (; from + 1 < size; ++from) {
+        if (data[from] == 'M' && data[from + 1] == 'Z') {
+            return from;
+        }
+    }
+
+    return size;
+}
+
+#if defined(ZEN_TARGET_X86)
+// Compares every byte and its successor at once through a second load one byte further on.
+ZEN_TARGET_FEATURES("sse2")
+inline
+auto
+find_mz_sse2(
+    const u8* const data,
+    const szt       size,
+    szt             from
+) noexcept -> szt
+{
+    const auto m = _mm_set1_epi8('M');
+    const auto z = _mm_set1_epi8('Z');
+
+    for (; from + 17 <= size; from += 16) {
+        const auto lo   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + from));
+        const auto hi   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + from + 1));
+        const auto hits = static_cast<u32>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(lo, m), _mm_cmpeq_epi8(hi, z))));
+
+        if (hits != 0) {
+            return from + static_cast<szt>(std::countr_zero(hits));
+        }
+    }
+
+    return find_mz_scalar(data, size, from);
+}
+
+ZEN_TARGET_FEATURES("avx2")
+inline
+auto
+find_mz_avx2(
+    const u8* const data,
+    const szt       size,
+    szt             from
+) noexcept -> szt
+{
+    const auto m = _mm256_set1_epi8('M');
+    const auto z = _mm256_set1_epi8('Z');
+
+    for (; from + 65 <= size; from += 64) {
+        const auto lo0  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + from));
+        const auto hi0  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + from + 1));
+        const auto lo1  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + from + 32));
+        const auto hi1  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + from + 33));
+        const auto hit0 = _mm256_and_si256(_mm256_cmpeq_epi8(lo0, m), _mm256_cmpeq_epi8(hi0, z));
+        const auto hit1 = _mm256_and_si256(_mm256_cmpeq_epi8(lo1, m), _mm256_cmpeq_epi8(hi1, z));
+
+        if (_mm256_testz_si256(_mm256_or_si256(hit0, hit1), _mm256_or_si256(hit0, hit1))) {
+            continue;
+        }
+
+        const auto hits = static_cast<u64>(static_cast<u32>(_mm256_movemask_epi8(hit0)))
+            | static_cast<u64>(static_cast<u32>(_mm256_movemask_epi8(hit1))) << 32;
+
+        return from + static_cast<szt>(std::countr_zero(hits));
+    }
+
+    return find_mz_sse2(data, size, from);
+}
+#elif defined(__aarch64__) || defined(_M_ARM64)
+inline
+auto
+find_mz_neon(
+    const u8* const data,
+    const szt       size,
+    szt             from
+) noexcept -> szt
+{
+    const auto m = vdupq_n_u8('M');
+    const auto z = vdupq_n_u8('Z');
+
+    for (; from + 17 <= size; from += 16) {
+        const auto hits = vandq_u8(vceqq_u8(vld1q_u8(data + from), m), vceqq_u8(vld1q_u8(data + from + 1), z));
+
+        // shrink every 0xFF/0x00 byte to a nibble, the first set nibble is the first hit
+        const auto mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+
+        if (mask != 0) {
+            return from + static_cast<szt>(std::countr_zero(mask) / 4);
+        }
+    }
+
+    return find_mz_scalar(data, size, from);
+}
+#endif
+
+NODISCARD
+inline
+auto
+find_mz(
+    const u8* const data,
+    const szt       size,
+    const szt       from
+) noexcept -> szt
+{
+#if defined(ZEN_TARGET_X86)
+    static const auto features = cpu();
+
+    if (features.avx2) {
+        return find_mz_avx2(data, size, from);
+    }
+
+    if (features.sse2) {
+        return find_mz_sse2(data, size, from);
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    return find_mz_neon(data, size, from);
+#endif
+
+    return find_mz_scalar(data, size, from);
+}
+} //namespace zen::detail
+
+namespace zen::win {
+struct carve_options
+{
+    // Largest e_lfanew accepted, real images keep the NT headers within the first page or two.
+    szt  max_nt_offset{0x10000};
+    u16  max_sections{96};
+    // Report images that start inside the extent of an image found before them, such as a
+    // dropper carrying its payload in the overlay. Off skips the extent of every image found.
+    bool nested{true};
+};
+
+// A PE found in a blob. `data` views the blob from the DOS header up to the extent of the image
+// (the raw_limit() of the headers), cut off at the end of the blob.
+struct carved_image
+{
+    szt                 offset{};
+    szt                 extent{};
+    std::span<const u8> data{};
+    bool                x64{};
+
+    NODISCARD
+    auto
+    truncated() const noexcept -> bool
+    {
+        return data.size() < extent;
+    }
+
+    // The image, nullptr if it has the other bitness. The win types assume 4-byte alignment, copy
+    // an image found at a misaligned offset out before using the view on strict targets.
+    template<bool X64 = detail::is_64_bit>
+    NODISCARD
+    auto
+    view() const noexcept -> const image<X64>*
+    {
+        return x64 == X64 ? reinterpret_cast<const image<X64>*>(data.data()) : nullptr;
+    }
+};
+
+// Checks the headers of the candidate at the start of `blob`, which starts with "MZ". Everything
+// read has to lie inside the blob; returns the extent of the image or 0.
+template<bool X64>
+NODISCARD
+auto
+carve_extent(
+    const std::span<const u8> blob,
+    const szt                 nt_ptr,
+    const carve_options&      options
+) noexcept -> szt
+{
+    const auto* const img = reinterpret_cast<const image<X64>*>(blob.data());
+    const auto* const nt  = img->nt_hdr();
+    const auto&       opt = nt->optional_hdr();
+
+    const auto opt_size = nt->file_hdr().size_optional_header();
+    const auto fixed    = sizeof(optional_header<X64>) - sizeof(opt.data_directories());
+    const auto table    = nt_ptr + sizeof(u32) + sizeof(coff::file_header) + opt_size;
+    const auto count    = nt->file_hdr().num_sections();
+
+    if (opt_size < fixed
+        || opt_size > sizeof(optional_header<X64>)
+        || count == 0
+        || count > options.max_sections
+        || table + count * sizeof(coff::section_header) > blob.size()
+        || !std::has_single_bit(opt.file_alignment())
+        || !std::has_single_bit(opt.section_alignment())
+        || opt.file_alignment() > opt.section_alignment()
+        || opt.size_image() == 0
+        || opt.num_data_directories() > 16
+    ) {
+        return 0;
+    }
+
+    // raw_limit() reads the security directory, which has to be inside the optional header
+    if (opt.num_data_directories() > static_cast<u32>(win::directory::security)
+        && fixed + (static_cast<szt>(win::directory::security) + 1) * sizeof(data_directory) > opt_size
+    ) {
+        return 0;
+    }
+
+    const auto* const scn = nt->template sections<false>();
+
+    for (szt i{}; i < count; ++i) {
+        if (scn[i].virtual_address() >= opt.size_image()
+            || static_cast<u64>(scn[i].ptr_raw_data()) + scn[i].size_raw_data() > 0xFFFFFFFFull
+        ) {
+            return 0;
+        }
+    }
+
+    return img->raw_limit();
+}
+
+// Calls `fn(const carved_image&)` for every PE in `blob` in order of offset, a bool returning
+// `fn` stops the scan by returning false. Candidates are found with a vectorised search for "MZ",
+// then e_lfanew, the NT signature, the optional header and the section table are checked; only
+// the headers of a candidate are read and nothing is copied.
+template<class Fn>
+auto
+for_each_carved_image(
+    const std::span<const u8> blob,
+    Fn&&                      fn,
+    const carve_options&      options = {}
+) -> void
+{
+    constexpr szt lfanew   = 0x3C;
+    constexpr szt nt_fixed = sizeof(u32) + sizeof(coff::file_header) + sizeof(u16);
+
+    std::vector<u8> headers;
+
+    for (szt at = detail::find_mz(blob.data(), blob.size(), 0); at < blob.size(); ) {
+        const auto rest   = blob.subspan(at);
+        szt        extent = 0;
+        bool       x64    = false;
+
+        if (rest.size() >= sizeof(dos_header)) {
+            const auto nt_ptr = static_cast<szt>(bit::load_little<u32>(rest.data() + lfanew));
+
+            if (nt_ptr % sizeof(u32) == 0
+                && nt_ptr >= sizeof(u32)
+                && nt_ptr <= options.max_nt_offset
+                && nt_ptr + nt_fixed <= rest.size()
+                && bit::load_little<u32>(rest.data() + nt_ptr) == nt_headers<true>::magic_value
+            ) {
+                const auto magic = bit::load_little<u16>(rest.data() + nt_ptr + sizeof(u32) + sizeof(coff::file_header));
+                auto       view  = rest;
+
+                // the win types need 4-byte alignment, the headers of a misaligned candidate are
+                // checked on a copy; raw_limit() doesn't read past the section table
+                if (reinterpret_cast<uintptr_t>(rest.data()) % alignof(image<true>) != 0) {
+                    const auto num_sections = bit::load_little<u16>(rest.data() + nt_ptr + sizeof(u32) + sizeof(u16));
+                    const auto size_opt     = bit::load_little<u16>(rest.data() + nt_ptr + sizeof(u32) + sizeof(u16) * 2 + sizeof(u32) * 3);
+                    const auto table_end    = nt_ptr + sizeof(u32) + sizeof(coff::file_header) + size_opt + num_sections * sizeof(coff::section_header);
+
+                    headers.assign(rest.begin(), rest.begin() + static_cast<std::ptrdiff_t>(std::min(table_end, rest.size())));
+
+                    view = headers;
+                }
+
+                if (magic == optional_header_base::magic_value_64_bit) {
+                    extent = carve_extent<true>(view, nt_ptr, options);
+                    x64    = true;
+                } else if (magic == optional_header_base::magic_value_32_bit) {
+                    extent = carve_extent<false>(view, nt_ptr, options);
+                }
+            }
+        }
+
+        auto next = at + 1;
+
+        if (extent != 0) {
+            const carved_image carved{at, extent, rest.first(std::min(extent, rest.size())), x64};
+
+            if constexpr (std::is_same_v<std::invoke_result_t<Fn&, const carved_image&>, bool>) {
+                if (!fn(carved)) {
+                    return;
+                }
+            } else {
+                fn(carved);
+            }
+
+            if (!options.nested) {
+                next = at + std::max<szt>(carved.data.size(), 1);
+            }
+        }
+
+        at = detail::find_mz(blob.data(), blob.size(), next);
+    }
+}
+
+NODISCARD
+inline
+auto
+carve_images(
+    const std::span<const u8> blob,
+    const carve_options&      options = {}
+) -> std::vector<carved_image>
+{
+    std::vector<carved_image> result;
+
+    for_each_carved_image(blob, [&result](const carved_image& carved) {
+        result.push_back(carved);
+    }, options);
+
+    return result;
+}
+} //namespace zen::win
@@ -0,0 +1,485 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/nt/checksum.hpp>
+#include <zen/nt/image.hpp>
+#include <zen/nt/directories/relocs.hpp>
+#include <zen/nt/reloc_encoder.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace zen::win {
+struct unmap_options
+{
+    // Address the dump was taken at, 0 takes the ImageBase of the dumped headers, which the
+    // loader rewrites to the actual base.
+    u64  loaded_base{};
+    // Base the relocations are undone to and written as ImageBase, 0 leaves them applied.
+    u64  preferred_base{};
+    // Drop the zero tail of every section, the loader zero fills it again.
+    bool trim{true};
+    bool checksum{true};
+};
+
+// Converts an image dumped from memory (sections at their RVA, up to size_image bytes) back to
+// file layout. The constructor plans the layout and only copies the headers, write() then streams
+// the file in order as views into the dump. Pages with relocations to undo go through a page
+// sized scratch buffer, so the dump is never duplicated. Certificates and the overlay aren't
+// mapped and are lost, the security directory is cleared.
+template<bool X64 = detail::is_64_bit>
+class image_unmapper
+{
+    struct section_plan
+    {
+        std::span<const u8> data;        // dump bytes written to the file
+        u32                 rva{};
+        u32                 size_raw{};  // data plus zero padding
+        szt                 fixup_begin{};
+        szt                 fixup_end{};
+    };
+
+public:
+    constexpr static u32 page_size = 0x1000;
+
+    // Fails for headers or section tables out of the dump and for a rebase of an image without
+    // usable relocations.
+    explicit
+    image_unmapper(
+        const std::span<const u8> memory,
+        const unmap_options&      options = {}
+    )
+    {
+        if (memory.size() < sizeof(dos_header)) {
+            return;
+        }
+
+        const auto* const img    = reinterpret_cast<const image<X64>*>(memory.data());
+        const auto        nt_ptr = static_cast<szt>(img->dos_hdr()->next_hdr_offset());
+
+        if (!img->dos_hdr()->valid()
+            || nt_ptr < sizeof(dos_header)
+            || nt_ptr > memory.size()
+            || memory.size() - nt_ptr < sizeof(nt_headers<X64>)
+        ) {
+            return;
+        }
+
+        const auto* const nt    = img->nt_hdr();
+        const auto&       opt   = nt->optional_hdr();
+        const auto        table = nt_ptr + sizeof(u32) + sizeof(coff::file_header) + nt->file_hdr().size_optional_header();
+        const auto        count = nt->file_hdr().num_sections();
+
+        if (!nt->valid()
+            || nt->is_64_bit() != X64
+            || table > memory.size()
+            || (memory.size() - table) / sizeof(coff::section_header) < count
+        ) {
+            return;
+        }
+
+        auto file_algn = opt.file_alignment();
+
+        if (!std::has_single_bit(file_algn) || file_algn > opt.section_alignment()) {
+            file_algn = 0x200;
+        }
+
+        const auto table_end = table + count * sizeof(coff::section_header);
+        const auto headers   = align_up(std::max<szt>(opt.size_headers(), table_end), file_algn);
+
+        headers_.assign(headers, 0);
+        std::memcpy(headers_.data(), memory.data(), std::min(headers, memory.size()));
+
+        const auto loaded = options.loaded_base != 0 ? options.loaded_base : static_cast<u64>(opt.image_base());
+
+        delta_ = options.preferred_base != 0 ? static_cast<i64>(options.preferred_base - loaded) : 0;
+
+        if (delta_ != 0 && !collect_fixups(memory, *img)) {
+            return;
+        }
+
+        const auto* const scn = reinterpret_cast<const coff::section_header*>(memory.data() + table);
+        auto*       const out = reinterpret_cast<coff::section_header*>(headers_.data() + table);
+
+        std::vector<reloc_fixup> kept;
+
+        sections_.resize(count);
+
+        szt offset = headers;
+
+        for (szt i{}; i < count; ++i) {
+            auto&      plan = sections_[i];
+            const auto rva  = scn[i].virtual_address();
+            const auto ch   = scn[i].characteristics();
+            const auto size = scn[i].virtual_size() != 0 ? scn[i].virtual_size() : scn[i].size_raw_data();
+
+            plan.rva = rva;
+
+            // uninitialized data has nothing to write, its raw size stays 0
+            if (ch.cnt_uninit_data && !ch.cnt_init_data && !ch.cnt_code) {
+                out[i].ptr_raw_data(0);
+                out[i].size_raw_data(0);
+                continue;
+            }
+
+            const auto begin = std::min<szt>(rva, memory.size());
+            const auto end   = std::min<szt>(static_cast<szt>(rva) + size, memory.size());
+            auto       used  = end - begin;
+
+            // keep the fixups that lie completely inside the section and don't overlap each other
+            plan.fixup_begin = kept.size();
+
+            auto it = std::lower_bound(fixups_.begin(), fixups_.end(), rva, [](const reloc_fixup& fixup, const u32 value) {
+                return fixup.rva < value;
+            });
+
+            for (szt last_end = begin; it != fixups_.end() && it->rva < end; ++it) {
+                const auto width = reloc_width(it->type);
+
+                if (it->rva >= last_end && it->rva + width <= end) {
+                    kept.push_back(*it);
+                    last_end = it->rva + width;
+                }
+            }
+
+            plan.fixup_end = kept.size();
+
+            if (options.trim) {
+                used = last_nonzero(memory.subspan(begin, used));
+
+                if (plan.fixup_end != plan.fixup_begin) {
+                    const auto& last = kept[plan.fixup_end - 1];
+
+                    used = std::max<szt>(used, last.rva + reloc_width(last.type) - begin);
+                }
+            }
+
+            const auto raw = align_up(used, file_algn);
+
+            plan.data     = memory.subspan(begin, std::min(raw, end - begin));
+            plan.size_raw = static_cast<u32>(raw);
+
+            out[i].ptr_raw_data(raw != 0 ? static_cast<u32>(offset) : 0);
+            out[i].size_raw_data(static_cast<u32>(raw));
+
+            offset += raw;
+        }
+
+        if (offset > 0xFFFFFFFFull) {
+            return;
+        }
+
+        fixups_    = std::move(kept);
+        file_size_ = offset;
+
+        auto* const nt_out  = reinterpret_cast<nt_headers<X64>*>(headers_.data() + nt_ptr);
+        auto&       opt_out = nt_out->optional_hdr();
+
+        opt_out.file_alignment(file_algn);
+        opt_out.size_headers(static_cast<u32>(headers));
+        opt_out.checksum(0);
+
+        if (options.preferred_base != 0) {
+            opt_out.image_base(static_cast<decltype(opt_out.image_base())>(options.preferred_base));
+        }
+
+        if (opt_out.num_data_directories() > static_cast<u16>(win::directory::security)) {
+            opt_out.data_directories().at(win::directory::security).rva(0);
+            opt_out.data_directories().at(win::directory::security).size(0);
+        }
+
+        if (options.checksum) {
+            const auto value = bit::little(compute_checksum());
+
+            std::memcpy(headers_.data() + checksum_offset(headers_), &value, sizeof(value));
+        }
+
+        valid_ = true;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return valid_;
+    }
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    auto
+    file_size() const noexcept -> szt
+    {
+        return file_size_;
+    }
+
+    // Rewritten headers, padded to the file alignment.
+    NODISCARD
+    auto
+    headers() const noexcept -> std::span<const u8>
+    {
+        return headers_;
+    }
+
+    // Passes the file to `sink(std::span<const u8>) -> bool` front to back in one pass, stopping at
+    // the first false. Chunks are only valid during the call.
+    template<class Sink>
+    NODISCARD
+    auto
+    write(
+        Sink&& sink
+    ) const -> bool
+    {
+        if (!valid_ || !sink(std::span<const u8>{headers_})) {
+            return false;
+        }
+
+        for (const auto& plan : sections_) {
+            if (!stream_section(plan, sink)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Collects write() into one buffer, for callers that want the file in memory.
+    NODISCARD
+    auto
+    flatten() const -> std::vector<u8>
+    {
+        std::vector<u8> result;
+
+        result.reserve(file_size_);
+
+        const auto written = write([&](const std::span<const u8> chunk) {
+            result.insert(result.end(), chunk.begin(), chunk.end());
+            return true;
+        });
+
+        if (!written) {
+            result.clear();
+        }
+
+        return result;
+    }
+
+private:
+    NODISCARD
+    static
+    constexpr
+    auto
+    align_up(
+        const szt value,
+        const szt alignment
+    ) noexcept -> szt
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Length of `data` without its zero tail.
+    NODISCARD
+    static
+    auto
+    last_nonzero(
+        const std::span<const u8> data
+    ) noexcept -> szt
+    {
+        auto size = data.size();
+
+        for (; size >= sizeof(u64); size -= sizeof(u64)) {
+            if (bit::load_little<u64>(data.data() + size - sizeof(u64)) != 0) {
+                break;
+            }
+        }
+
+        while (size != 0 && data[size - 1] == 0) {
+            --size;
+        }
+
+        return size;
+    }
+
+    // Reads the relocation directory of the dump, the loader doesn't touch it.
+    NODISCARD
+    auto
+    collect_fixups(
+        const std::span<const u8> memory,
+        const image<X64>&         img
+    ) -> bool
+    {
+        const auto* const dir = img.directory(win::directory::basereloc);
+
+        if (dir == nullptr
+            || img.file_hdr()->characteristics().relocs_stripped
+            || dir->rva() > memory.size()
+            || memory.size() - dir->rva() < dir->size()
+        ) {
+            return false;
+        }
+
+        const auto* at  = memory.data() + dir->rva();
+        const auto* end = at + dir->size();
+
+        while (static_cast<szt>(end - at) >= sizeof(u32) * 2) {
+            const auto base = bit::load_little<u32>(at);
+            const auto size = bit::load_little<u32>(at + sizeof(u32));
+
+            if (size < sizeof(u32) * 2 || size > static_cast<szt>(end - at)) {
+                break;
+            }
+
+            for (auto* entry = at + sizeof(u32) * 2; entry + sizeof(u16) <= at + size; entry += sizeof(u16)) {
+                const reloc_entry item{bit::load_little<u16>(entry)};
+
+                if (reloc_width(item.type()) != 0) {
+                    fixups_.push_back({base + item.offset(), item.type()});
+                } else if (item.type() != reloc_type::based_absolute) {
+                    return false;
+                }
+            }
+
+            at += size;
+        }
+
+        const auto by_rva = [](const reloc_fixup& lhs, const reloc_fixup& rhs) {
+            return lhs.rva < rhs.rva;
+        };
+
+        if (!std::is_sorted(fixups_.begin(), fixups_.end(), by_rva)) {
+            std::vector<reloc_fixup> scratch(fixups_.size());
+
+            sort_relocs(fixups_, scratch);
+        }
+
+        return true;
+    }
+
+    // Calls `emit(chunk)` for the raw data of the section in file order, pages holding fixups are
+    // copied and patched first.
+    template<class Emit>
+    auto
+    stream_section(
+        const section_plan& plan,
+        Emit&&              emit
+    ) const -> bool
+    {
+        constexpr static std::array<u8, page_size> zeros{};
+
+        std::array<u8, page_size + sizeof(u64)> scratch;
+
+        const auto* const base = plan.data.data();
+        const auto        size = plan.data.size();
+
+        szt at{};
+        auto k = plan.fixup_begin;
+
+        while (at < size) {
+            if (k == plan.fixup_end) {
+                if (!emit(plan.data.subspan(at))) {
+                    return false;
+                }
+
+                break;
+            }
+
+            const auto page = std::max<szt>(at, (fixups_[k].rva - plan.rva) & ~szt{page_size - 1});
+
+            if (page != at && !emit(plan.data.subspan(at, page - at))) {
+                return false;
+            }
+
+            // a fixup straddling the page end pulls its remaining bytes into the chunk
+            auto       chunk_end = std::min<szt>(page + page_size, size);
+            const auto first     = k;
+
+            for (; k != plan.fixup_end && fixups_[k].rva - plan.rva < chunk_end; ++k) {
+                chunk_end = std::max<szt>(chunk_end, fixups_[k].rva - plan.rva + reloc_width(fixups_[k].type));
+            }
+
+            std::memcpy(scratch.data(), base + page, chunk_end - page);
+
+            for (auto j = first; j != k; ++j) {
+                apply_relocation(scratch.data() + (fixups_[j].rva - plan.rva - page), fixups_[j].type, delta_);
+            }
+
+            if (!emit(std::span<const u8>{scratch.data(), chunk_end - page})) {
+                return false;
+            }
+
+            at = chunk_end;
+        }
+
+        for (auto pad = static_cast<szt>(plan.size_raw) - size; pad != 0;) {
+            const auto n = std::min(pad, zeros.size());
+
+            if (!emit(std::span<const u8>{zeros.data(), n})) {
+                return false;
+            }
+
+            pad -= n;
+        }
+
+        return true;
+    }
+
+    // The checksum sits in the headers, so it needs a read-only pass over the planned file.
+    NODISCARD
+    auto
+    compute_checksum() const noexcept -> u32
+    {
+        pe_checksum sum{checksum_offset(headers_)};
+
+        sum.update(headers_);
+
+        for (const auto& plan : sections_) {
+            stream_section(plan, [&](const std::span<const u8> chunk) {
+                sum.update(chunk);
+                return true;
+            });
+        }
+
+        return sum.finalize();
+    }
+
+    std::vector<u8>           headers_{};
+    std::vector<section_plan> sections_{};
+    std::vector<reloc_fixup>  fixups_{};
+    szt                       file_size_{};
+    i64                       delta_{};
+    bool                      valid_{false};
+};
+} //namespace zen::win
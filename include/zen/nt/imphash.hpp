@@ -0,0 +1,218 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/hash128.hpp>
+#include <zen/core/string.hpp>
+#include <zen/crypto/md5.hpp>
+#include <zen/nt/image.hpp>
+#include <zen/nt/directories/iat.hpp>
+#include <zen/nt/directories/imports.hpp>
+#include <zen/nt/ordinal_names.hpp>
+#include <charconv>
+#include <string_view>
+
+namespace zen::win {
+// Lowercases the text it is fed into a small buffer that is flushed into the hasher whenever it
+// fills up, so the hashed string never exists as a whole.
+template<class Hash>
+class imphash_writer
+{
+public:
+    explicit
+    imphash_writer(
+        Hash& hasher
+    ) noexcept
+        : hasher_{ hasher }
+    {}
+
+    auto
+    put(
+        const std::string_view text
+    ) noexcept -> imphash_writer&
+    {
+        for (const auto c : text) {
+            if (size_ == sizeof(buffer_)) {
+                flush();
+            }
+
+            buffer_[size_++] = ascii_lower(c);
+        }
+
+        return *this;
+    }
+
+    auto
+    flush() noexcept -> void
+    {
+        hasher_.update(buffer_, size_);
+
+        size_ = 0;
+    }
+
+private:
+    Hash& hasher_;
+    char  buffer_[256]{};
+    szt   size_{};
+};
+
+// Module name the way imphash spells it: the .dll, .ocx and .sys extensions are dropped.
+NODISCARD
+constexpr
+auto
+imphash_module_name(
+    const std::string_view module
+) noexcept -> std::string_view
+{
+    const auto dot = module.rfind('.');
+
+    if (dot == std::string_view::npos) {
+        return module;
+    }
+
+    const auto extension = module.substr(dot + 1);
+
+    return equals_ignore_case(extension, "dll")
+        || equals_ignore_case(extension, "ocx")
+        || equals_ignore_case(extension, "sys")
+        ? module.substr(0, dot)
+        : module;
+}
+
+// Invokes fn(module, function) for every import in descriptor order, ordinal imports are named
+// through the ordinal tables and fall back to "ord<N>". Both views only live for the call.
+// Returns false if the image has no import directory.
+template<bool X64, class Fn>
+auto
+for_each_import(
+    const image<X64>& img,
+    Fn&&              fn
+) -> bool
+{
+    const auto* const data_directory = img.directory(win::directory::imports);
+
+    if (!data_directory || data_directory->rva() == 0) {
+        return false;
+    }
+
+    for (auto rva = data_directory->rva();; rva += sizeof(import_directory)) {
+        const auto* const desc = img.template rva_to_ptr<import_directory>(rva, sizeof(import_directory));
+
+        if (!desc || desc->rva_name() == 0) {
+            break;
+        }
+
+        const auto* const module_raw = img.template rva_to_ptr<char>(desc->rva_name());
+
+        if (!module_raw || *module_raw == 0) {
+            continue;
+        }
+
+        const std::string_view module{module_raw};
+
+        const auto thunk_rva = desc->rva_original_first_thunk() != 0
+            ? desc->rva_original_first_thunk()
+            : desc->rva_first_thunk();
+
+        for (auto entry_rva = thunk_rva;; entry_rva += sizeof(va_t<X64>)) {
+            const auto* const entry = img.template rva_to_ptr<image_thunk_data<X64>>(entry_rva, sizeof(va_t<X64>));
+
+            if (!entry || entry->address() == 0) {
+                break;
+            }
+
+            std::string_view function;
+            char             ordinal_buffer[8]{'o', 'r', 'd'};
+
+            if (entry->is_ordinal()) {
+                function = ordinal_to_name(module, entry->ordinal());
+
+                if (function.empty()) {
+                    const auto [end, ec] = std::to_chars(ordinal_buffer + 3, std::end(ordinal_buffer), entry->ordinal());
+
+                    function = {ordinal_buffer, end};
+                }
+            } else if (const auto* const import_by_name = img.template rva_to_ptr<image_named_import>(static_cast<u32>(entry->address()))) {
+                function = import_by_name->name();
+            }
+
+            if (!function.empty()) {
+                fn(module, function);
+            }
+        }
+    }
+
+    return true;
+}
+
+// Feeds the comma separated "module.function" list of the import directory into `hasher` in
+// descriptor order, laid out like pefile's get_imphash(). The value only matches pefile when every
+// ordinal import is named, see ordinal_names.hpp. Returns false if the image has no imports.
+template<class Hash, bool X64 = detail::is_64_bit>
+auto
+imphash_update(
+    const image<X64>& img,
+    Hash&             hasher
+) noexcept -> bool
+{
+    imphash_writer<Hash> writer{hasher};
+    bool                 first{true};
+
+    const auto found = for_each_import(img, [&](const std::string_view module, const std::string_view function) {
+        if (!first) {
+            writer.put(",");
+        }
+
+        writer.put(imphash_module_name(module)).put(".").put(function);
+
+        first = false;
+    });
+
+    writer.flush();
+
+    return found;
+}
+
+// imphash with any zen::crypto style hasher, MD5 gives the conventional value. zen::hash128 is
+// several times cheaper when the digest only has to be compared against others of its kind.
+template<class Hash = crypto::md5, bool X64 = detail::is_64_bit>
+NODISCARD
+auto
+imphash(
+    const image<X64>&           img,
+    typename Hash::digest_type& digest
+) noexcept -> bool
+{
+    Hash hasher;
+
+    if (!imphash_update(img, hasher)) {
+        return false;
+    }
+
+    digest = hasher.finalize();
+
+    return true;
+}
+} //namespace zen::win
@@ -0,0 +1,363 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/parallel.hpp>
+#include <zen/core/string.hpp>
+#include <zen/nt/directories/iat.hpp>
+#include <zen/nt/directories/imports.hpp>
+#include <zen/nt/export_index.hpp>
+#include <array>
+#include <charconv>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+namespace zen::win {
+struct bind_result
+{
+    u32 resolved{};
+    u32 forwarded{};
+    u32 unresolved{};
+    u32 hint_hits{};
+    u32 hint_misses{};
+};
+
+// Resolves the imports of file layout images against a registry of module images, the same way
+// the loader would fill the IAT in a process where every registered module is loaded at its base.
+// Export indexes are built once per module in add_module() and shared by every later bind().
+template<bool X64 = detail::is_64_bit>
+class import_binder
+{
+    struct module
+    {
+        export_index<X64> exports;
+        u64               base{};
+    };
+
+    struct key_hash
+    {
+        using is_transparent = void;
+
+        NODISCARD
+        auto
+        operator()(
+            const std::string_view key
+        ) const noexcept -> szt
+        {
+            return std::hash<std::string_view>{}(key);
+        }
+    };
+
+    using key_buffer = std::array<char, 256>;
+
+public:
+    constexpr static u32 max_forward_depth = 8;
+
+    import_binder() = default;
+
+    auto
+    add_module(
+        const std::string_view name,
+        export_index<X64>      exports,
+        const u64              base
+    ) -> void
+    {
+        key_buffer buffer;
+
+        modules_.insert_or_assign(
+            std::string{module_key(name, buffer)},
+            module{std::move(exports), base}
+        );
+    }
+
+    auto
+    add_module(
+        const std::string_view name,
+        const image<X64>&      img
+    ) -> void
+    {
+        add_module(name, export_index<X64>{img}, img.optional_hdr()->image_base());
+    }
+
+    auto
+    add_module(
+        const image<X64>& img
+    ) -> void
+    {
+        export_index<X64> exports{img};
+        const auto        name = exports.name();
+
+        add_module(name, std::move(exports), img.optional_hdr()->image_base());
+    }
+
+    NODISCARD
+    auto
+    num_modules() const noexcept -> szt
+    {
+        return modules_.size();
+    }
+
+    NODISCARD
+    auto
+    resolve(
+        const std::string_view module_name,
+        const std::string_view name
+    ) const noexcept -> u64
+    {
+        bool forwarded{};
+
+        return resolve(find_module(module_name), name, 0, forwarded);
+    }
+
+    NODISCARD
+    auto
+    resolve(
+        const std::string_view module_name,
+        const u16              ordinal
+    ) const noexcept -> u64
+    {
+        bool forwarded{};
+
+        return resolve(find_module(module_name), ordinal, 0, forwarded);
+    }
+
+    NODISCARD
+    auto
+    resolve(
+        const std::string_view module_name,
+        const std::string_view name,
+        const u16              hint
+    ) const noexcept -> u64
+    {
+        const auto* const mod = find_module(module_name);
+        bool              forwarded{};
+
+        return mod ? follow(*mod, mod->exports.find(name, hint), 0, forwarded) : 0;
+    }
+
+    // Fills every IAT slot of `target`. Slots that can't be resolved are set to zero.
+    auto
+    bind(
+        image<X64>& target
+    ) const noexcept -> bind_result
+    {
+        const auto* const data_directory = target.directory(win::directory::imports);
+
+        if (!data_directory) {
+            return {};
+        }
+
+        bind_result result{};
+
+        for (auto rva = data_directory->rva();; rva += sizeof(import_directory)) {
+            const auto* const descriptor = target.template rva_to_ptr<import_directory>(rva, sizeof(import_directory));
+
+            if (!descriptor || (descriptor->rva_name() == 0 && descriptor->rva_first_thunk() == 0)) {
+                break;
+            }
+
+            const auto bound = bind_descriptor(target, *descriptor);
+
+            result.resolved    += bound.resolved;
+            result.forwarded   += bound.forwarded;
+            result.unresolved  += bound.unresolved;
+            result.hint_hits   += bound.hint_hits;
+            result.hint_misses += bound.hint_misses;
+        }
+
+        return result;
+    }
+
+    // Binds every image of `targets` with a single parallel_for over the images, each image is
+    // bound serially by one worker. `results` receives the outcome per image and has to hold
+    // targets.size() entries.
+    auto
+    bind(
+        const std::span<image<X64>* const> targets,
+        const std::span<bind_result>       results,
+        const u32                          threads = 0
+    ) const -> void
+    {
+        const auto count = std::min(targets.size(), results.size());
+
+        parallel_for(count, [&](const szt index) {
+            results[index] = targets[index] ? bind(*targets[index]) : bind_result{};
+        }, threads);
+    }
+
+private:
+    NODISCARD
+    static
+    auto
+    module_key(
+        std::string_view name,
+        key_buffer&      buffer
+    ) noexcept -> std::string_view
+    {
+        if (name.size() > 4 && equals_ignore_case(name.substr(name.size() - 4), ".dll")) {
+            name.remove_suffix(4);
+        }
+
+        const auto length = std::min(name.size(), buffer.size());
+
+        std::ranges::transform(name.substr(0, length), buffer.begin(), ascii_lower);
+
+        return {buffer.data(), length};
+    }
+
+    NODISCARD
+    auto
+    find_module(
+        const std::string_view name
+    ) const noexcept -> const module*
+    {
+        key_buffer buffer;
+
+        const auto it = modules_.find(module_key(name, buffer));
+
+        return it != modules_.end() ? &it->second : nullptr;
+    }
+
+    template<class Key>
+    NODISCARD
+    auto
+    resolve(
+        const module* const mod,
+        const Key           key,
+        const u32           depth,
+        bool&               forwarded
+    ) const noexcept -> u64
+    {
+        if (!mod || depth > max_forward_depth) {
+            return 0;
+        }
+
+        return follow(*mod, mod->exports.find(key), depth, forwarded);
+    }
+
+    NODISCARD
+    auto
+    follow(
+        const module&             mod,
+        const export_entry* const entry,
+        const u32                 depth,
+        bool&                     forwarded
+    ) const noexcept -> u64
+    {
+        if (!entry) {
+            return 0;
+        }
+
+        if (!entry->forwarded()) {
+            return mod.base + entry->rva;
+        }
+
+        // e.g. "NTDLL.RtlAllocateHeap" or "NTDLL.#12"
+        const auto dot_pos = entry->forward.find('.');
+
+        if (dot_pos == std::string_view::npos) {
+            return 0;
+        }
+
+        forwarded = true;
+
+        const auto* const target   = find_module(entry->forward.substr(0, dot_pos));
+        const auto        function = entry->forward.substr(dot_pos + 1);
+
+        if (!function.empty() && function[0] == '#') {
+            u16 ordinal{};
+
+            if (std::from_chars(function.data() + 1, function.data() + function.size(), ordinal).ec != std::errc{}) {
+                return 0;
+            }
+
+            return resolve(target, ordinal, depth + 1, forwarded);
+        }
+
+        return resolve(target, function, depth + 1, forwarded);
+    }
+
+    NODISCARD
+    auto
+    bind_descriptor(
+        image<X64>&             target,
+        const import_directory& descriptor
+    ) const noexcept -> bind_result
+    {
+        bind_result result{};
+
+        const auto* const module_name = target.template rva_to_ptr<const char>(descriptor.rva_name());
+        const auto* const mod         = module_name ? find_module(module_name) : nullptr;
+
+        const auto lookup_rva = descriptor.rva_original_first_thunk() != 0
+            ? descriptor.rva_original_first_thunk()
+            : descriptor.rva_first_thunk();
+
+        for (u32 i{};; ++i) {
+            const auto  offset = i * static_cast<u32>(sizeof(image_thunk_data<X64>));
+            const auto* lookup = target.template rva_to_ptr<image_thunk_data<X64>>(lookup_rva + offset, sizeof(image_thunk_data<X64>));
+            auto*       slot   = target.template rva_to_ptr<image_thunk_data<X64>>(descriptor.rva_first_thunk() + offset, sizeof(image_thunk_data<X64>));
+
+            if (!lookup || !slot || lookup->address() == 0) {
+                break;
+            }
+
+            u64  address{};
+            bool forwarded{};
+
+            if (lookup->is_ordinal()) {
+                address = resolve(mod, lookup->ordinal(), 0, forwarded);
+            } else if (
+                const auto* const named = target.template rva_to_ptr<image_named_import>(
+                    static_cast<u32>(lookup->address()),
+                    sizeof(u16) + 1
+                )
+            ) {
+                if (mod) {
+                    bool hint_hit{};
+
+                    address = follow(*mod, mod->exports.find(named->name(), named->hint(), hint_hit), 0, forwarded);
+
+                    ++(hint_hit ? result.hint_hits : result.hint_misses);
+                }
+            }
+
+            slot->function(static_cast<va_t<X64>>(address));
+
+            if (address == 0) {
+                ++result.unresolved;
+            } else {
+                ++result.resolved;
+                result.forwarded += forwarded;
+            }
+        }
+
+        return result;
+    }
+
+    std::unordered_map<std::string, module, key_hash, std::equal_to<>> modules_;
+};
+} //namespace zen::win
@@ -0,0 +1,474 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/string.hpp>
+#include <zen/nt/directories/iat.hpp>
+#include <zen/nt/directories/imports.hpp>
+#include <zen/nt/image_builder.hpp>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace zen::win {
+// Rebuilds the import directory of a file layout image with additional modules and functions.
+// The new section holds a fresh descriptor table and lookup tables for every module, plus IATs and
+// hint/name entries for what was added. Existing descriptors keep their IAT RVAs, so code calling
+// through them stays valid; functions added to a module that is already imported go into a second
+// descriptor for the same DLL, which the loader handles like any other. Names are views into the
+// image or the strings passed to add() and have to outlive build().
+template<bool X64 = detail::is_64_bit>
+class import_builder
+{
+    using thunk_type = va_t<X64>;
+
+    constexpr static thunk_type ordinal_flag = thunk_type{1} << (sizeof(thunk_type) * 8 - 1);
+
+    struct function
+    {
+        std::string_view name{};   // Empty when importing by ordinal.
+        u16              hint{};   // Ordinal when importing by ordinal.
+        thunk_type       thunk{};  // Original lookup value, 0 for added functions.
+        u32              iat_rva{};
+    };
+
+    struct descriptor
+    {
+        std::string_view      module{};
+        u32                   rva_name{};  // Set by build() for added descriptors.
+        u32                   rva_iat{};   // Set by build() for added descriptors.
+        u32                   timedate_stamp{};
+        u32                   forwarder_chain{};
+        std::vector<function> functions{};
+    };
+
+public:
+    constexpr
+    import_builder() noexcept = default;
+
+    // Reads the descriptors of `img`, lookup tables fall back to the IAT when a descriptor has
+    // none. Fails on anything out of bounds.
+    explicit
+    import_builder(
+        const image<X64>& img
+    )
+    {
+        const auto* const dir = img.directory(win::directory::imports);
+
+        if (!dir) {
+            return;
+        }
+
+        for (auto rva = dir->rva();; rva += sizeof(import_directory)) {
+            const auto* const desc = img.template rva_to_ptr<import_directory>(rva, sizeof(import_directory));
+
+            if (!desc) {
+                valid_ = false;
+                return;
+            }
+
+            if (desc->rva_name() == 0 && desc->rva_first_thunk() == 0) {
+                break;
+            }
+
+            descriptor entry{
+                .module          = string_at(img, desc->rva_name()),
+                .rva_name        = desc->rva_name(),
+                .rva_iat         = desc->rva_first_thunk(),
+                .timedate_stamp  = desc->timedate_stamp(),
+                .forwarder_chain = desc->forwarder_chain(),
+                .functions       = {}
+            };
+
+            const auto lookup = desc->rva_original_first_thunk() != 0 ? desc->rva_original_first_thunk() : desc->rva_first_thunk();
+
+            for (u32 i{};; ++i) {
+                const auto* const thunk = img.template rva_to_ptr<image_thunk_data<X64>>(lookup + i * sizeof(thunk_type), sizeof(thunk_type));
+
+                if (!thunk) {
+                    valid_ = false;
+                    return;
+                }
+
+                if (thunk->address() == 0) {
+                    break;
+                }
+
+                function fn{.thunk = thunk->address(), .iat_rva = entry.rva_iat + i * static_cast<u32>(sizeof(thunk_type))};
+
+                if (thunk->is_ordinal()) {
+                    fn.hint = thunk->ordinal();
+                } else if (const auto* const named = img.template rva_to_ptr<image_named_import>(static_cast<u32>(thunk->address()), sizeof(u16) + 1)) {
+                    fn.hint = named->hint();
+                    fn.name = string_at(img, static_cast<u32>(thunk->address()) + sizeof(u16));
+                }
+
+                entry.functions.push_back(fn);
+            }
+
+            if (entry.module.empty()) {
+                valid_ = false;
+                return;
+            }
+
+            descriptors_.push_back(std::move(entry));
+        }
+
+        existing_ = descriptors_.size();
+    }
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return valid_;
+    }
+
+    // Imports `name` from `module`, a no-op if it's already imported.
+    auto
+    add(
+        const std::string_view module,
+        const std::string_view name,
+        const u16              hint = 0
+    ) -> import_builder&
+    {
+        if (!find(module, name, 0)) {
+            added_descriptor(module).functions.push_back({.name = name, .hint = hint});
+        }
+
+        return *this;
+    }
+
+    auto
+    add(
+        const std::string_view module,
+        const u16              ordinal
+    ) -> import_builder&
+    {
+        if (!find(module, {}, ordinal)) {
+            added_descriptor(module).functions.push_back({.hint = ordinal});
+        }
+
+        return *this;
+    }
+
+    // Bytes of the section contents build() produces.
+    NODISCARD
+    auto
+    size() const noexcept -> u32
+    {
+        u32 size = static_cast<u32>((descriptors_.size() + 1) * sizeof(import_directory));
+
+        for (szt d{}; d < descriptors_.size(); ++d) {
+            const auto& desc  = descriptors_[d];
+            const auto  table = static_cast<u32>((desc.functions.size() + 1) * sizeof(thunk_type));
+
+            if (d < existing_) {
+                size += table;
+                continue;
+            }
+
+            size += table * 2;
+
+            for (const auto& fn : desc.functions) {
+                if (!fn.name.empty()) {
+                    size += hint_name_size(fn.name);
+                }
+            }
+
+            if (name_source(desc) == nullptr) {
+                size += static_cast<u32>(desc.module.size() + 1);
+            }
+        }
+
+        return size;
+    }
+
+    // Lays out the section for `rva` into `out`, which needs size() bytes. Afterwards directory()
+    // and iat_rva() describe the result.
+    NODISCARD
+    auto
+    build(
+        const u32           rva,
+        const std::span<u8> out
+    ) -> bool
+    {
+        if (!valid_ || out.size() < size()) {
+            return false;
+        }
+
+        std::memset(out.data(), 0, size());
+
+        const auto ptr_size = static_cast<u32>(sizeof(thunk_type));
+
+        rva_ = rva;
+
+        // descriptors, lookup tables, new IATs, then strings
+        auto tables = static_cast<u32>((descriptors_.size() + 1) * sizeof(import_directory));
+        auto iats   = tables;
+
+        for (const auto& desc : descriptors_) {
+            iats += static_cast<u32>((desc.functions.size() + 1) * ptr_size);
+        }
+
+        auto strings = iats;
+
+        for (auto d = existing_; d < descriptors_.size(); ++d) {
+            strings += static_cast<u32>((descriptors_[d].functions.size() + 1) * ptr_size);
+        }
+
+        for (szt d{}; d < descriptors_.size(); ++d) {
+            auto&      desc  = descriptors_[d];
+            const auto added = d >= existing_;
+
+            if (added) {
+                desc.rva_iat = rva + iats;
+                iats        += static_cast<u32>((desc.functions.size() + 1) * ptr_size);
+
+                if (const auto* const shared = name_source(desc)) {
+                    desc.rva_name = shared->rva_name;
+                } else {
+                    desc.rva_name = rva + strings;
+
+                    std::memcpy(out.data() + strings, desc.module.data(), desc.module.size());
+                    strings += static_cast<u32>(desc.module.size() + 1);
+                }
+            }
+
+            auto& entry = *reinterpret_cast<import_directory*>(out.data() + d * sizeof(import_directory));
+
+            entry.rva_original_first_thunk(rva + tables);
+            entry.timedate_stamp(desc.timedate_stamp);
+            entry.forwarder_chain(desc.forwarder_chain);
+            entry.rva_name(desc.rva_name);
+            entry.rva_first_thunk(desc.rva_iat);
+
+            for (u32 i{}; i < desc.functions.size(); ++i) {
+                auto& fn    = desc.functions[i];
+                auto  value = fn.thunk;
+
+                if (added) {
+                    if (fn.name.empty()) {
+                        value = ordinal_flag | fn.hint;
+                    } else {
+                        value = rva + strings;
+
+                        const auto hint = bit::little(fn.hint);
+
+                        std::memcpy(out.data() + strings, &hint, sizeof(hint));
+                        std::memcpy(out.data() + strings + sizeof(hint), fn.name.data(), fn.name.size());
+                        strings += hint_name_size(fn.name);
+                    }
+                }
+
+                const auto little = bit::little(value);
+
+                std::memcpy(out.data() + tables, &little, sizeof(little));
+                tables += ptr_size;
+
+                if (added) {
+                    fn.iat_rva = desc.rva_iat + i * ptr_size;
+
+                    // the IAT starts out as a copy of the lookup table, like a linker emits it
+                    std::memcpy(out.data() + (fn.iat_rva - rva), &little, sizeof(little));
+                }
+            }
+
+            tables += ptr_size;
+        }
+
+        return true;
+    }
+
+    // Import directory entry for the section, valid after build().
+    NODISCARD
+    auto
+    directory() const noexcept -> std::pair<u32, u32>
+    {
+        return {rva_, static_cast<u32>((descriptors_.size() + 1) * sizeof(import_directory))};
+    }
+
+    // IAT slot of an imported function, 0 if it isn't imported or build() hasn't run for it yet.
+    NODISCARD
+    auto
+    iat_rva(
+        const std::string_view module,
+        const std::string_view name
+    ) const noexcept -> u32
+    {
+        const auto* const fn = find(module, name, 0);
+
+        return fn ? fn->iat_rva : 0;
+    }
+
+    NODISCARD
+    auto
+    iat_rva(
+        const std::string_view module,
+        const u16              ordinal
+    ) const noexcept -> u32
+    {
+        const auto* const fn = find(module, {}, ordinal);
+
+        return fn ? fn->iat_rva : 0;
+    }
+
+    // Builds into `storage` and appends it to `builder` as a writable data section, pointing the
+    // import directory at it.
+    NODISCARD
+    auto
+    apply(
+        image_builder<X64>&    builder,
+        std::vector<u8>&       storage,
+        const std::string_view name = ".idata"
+    ) -> bool
+    {
+        storage.resize(size());
+
+        const auto rva = builder.next_rva();
+
+        if (!build(rva, storage)) {
+            return false;
+        }
+
+        coff::section_header header{};
+
+        std::memcpy(header.name().short_name, name.data(), std::min<szt>(name.size(), sizeof(header.name().short_name)));
+        header.virtual_address(rva);
+        header.characteristics(std::to_underlying(
+            coff::section_flags::content_initialized_data
+            | coff::section_flags::memory_read
+            | coff::section_flags::memory_write
+        ));
+
+        builder.add_section(header, storage);
+        builder.directory(win::directory::imports).rva(directory().first);
+        builder.directory(win::directory::imports).size(directory().second);
+
+        return true;
+    }
+
+private:
+    NODISCARD
+    static
+    auto
+    string_at(
+        const image<X64>& img,
+        const u32         rva
+    ) noexcept -> std::string_view
+    {
+        const auto* const scn = img.rva_to_section(rva);
+
+        if (!scn || rva - scn->virtual_address() >= scn->size_raw_data()) {
+            return {};
+        }
+
+        const auto  available = scn->size_raw_data() - (rva - scn->virtual_address());
+        const auto* text      = img.template rva_to_ptr<const char>(rva, 1);
+
+        return {text, strnlen(text, available)};
+    }
+
+    NODISCARD
+    static
+    auto
+    hint_name_size(
+        const std::string_view name
+    ) noexcept -> u32
+    {
+        return static_cast<u32>((sizeof(u16) + name.size() + 1 + 1) & ~szt{1});
+    }
+
+    NODISCARD
+    auto
+    find(
+        const std::string_view module,
+        const std::string_view name,
+        const u16              ordinal
+    ) const noexcept -> const function*
+    {
+        for (const auto& desc : descriptors_) {
+            if (!equals_ignore_case(desc.module, module)) {
+                continue;
+            }
+
+            for (const auto& fn : desc.functions) {
+                if (name.empty() ? fn.name.empty() && fn.hint == ordinal : fn.name == name) {
+                    return &fn;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Additions to a module go into the one added descriptor for it.
+    auto
+    added_descriptor(
+        const std::string_view module
+    ) -> descriptor&
+    {
+        for (auto i = existing_; i < descriptors_.size(); ++i) {
+            if (equals_ignore_case(descriptors_[i].module, module)) {
+                return descriptors_[i];
+            }
+        }
+
+        return descriptors_.emplace_back(descriptor{.module = module});
+    }
+
+    // An existing descriptor for the same module whose name string can be shared.
+    NODISCARD
+    auto
+    name_source(
+        const descriptor& desc
+    ) const noexcept -> const descriptor*
+    {
+        for (szt i{}; i < existing_; ++i) {
+            if (equals_ignore_case(descriptors_[i].module, desc.module)) {
+                return &descriptors_[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::vector<descriptor> descriptors_;
+    szt                     existing_{};
+    u32                     rva_{};
+    bool                    valid_{true};
+};
+} //namespace zen::win
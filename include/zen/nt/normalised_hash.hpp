@@ -0,0 +1,425 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/nt/checksum.hpp>
+#include <zen/nt/directories/debug.hpp>
+#include <zen/nt/image.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace zen::win {
+// Streaming content hash of a PE with the fields that change between rebuilds of the same sources
+// taken out: the file header, export directory and debug directory time stamps, the GUID and age
+// of RSDS CodeView records and the CheckSum are hashed as zeros, the security directory entry as
+// well, and the attribute certificate table is skipped. Chunks are passed in file order and are
+// never copied, only the headers are buffered until the section table is complete. The masked
+// fields are located from the headers, a CodeView record that comes before its debug directory
+// in the file is hashed as is. Input that isn't a PE is hashed unchanged.
+template<class Hash>
+class normalised_hasher
+{
+    enum struct mask_kind : u8
+    {
+        zero,
+        skip,
+    };
+
+    struct mask
+    {
+        szt       offset{};
+        szt       size{};
+        mask_kind kind{};
+    };
+
+    enum struct capture_kind : u8
+    {
+        debug_directory,
+        codeview,
+    };
+
+    struct capture
+    {
+        szt             offset{};
+        std::vector<u8> data{};
+        szt             filled{};
+        capture_kind    kind{};
+    };
+
+public:
+    // Headers claiming more than this are treated as not being a PE.
+    constexpr static szt max_header_size   = 0x100000;
+    constexpr static szt max_debug_entries = 64;
+
+    normalised_hasher() = default;
+
+    auto
+    update(
+        const std::span<const u8> chunk
+    ) -> normalised_hasher&
+    {
+        if (state_ != state::headers) {
+            process(chunk);
+            return *this;
+        }
+
+        header_.insert(header_.end(), chunk.begin(), chunk.end());
+
+        // header_size() only reaches the section table end once the headers in front are buffered
+        if (const auto needed = header_size(); needed == 0) {
+            state_ = state::raw;
+        } else if (header_.size() < needed) {
+            return *this;
+        } else {
+            state_ = plan() ? state::normalised : state::raw;
+        }
+
+        const auto buffered = std::move(header_);
+
+        process(buffered);
+
+        return *this;
+    }
+
+    // Returns the digest and resets the hasher for the next file.
+    NODISCARD
+    auto
+    finalize() -> typename Hash::digest_type
+    {
+        if (state_ == state::headers) {
+            hasher_.update(header_.data(), header_.size());
+        }
+
+        const auto digest = hasher_.finalize();
+
+        normalised_ = state_ == state::normalised;
+
+        header_.clear();
+        masks_.clear();
+        captures_.clear();
+        position_ = 0;
+        state_    = state::headers;
+
+        return digest;
+    }
+
+    // Whether the last finalized input was recognised as a PE and normalised.
+    NODISCARD
+    auto
+    normalised() const noexcept -> bool
+    {
+        return normalised_;
+    }
+
+private:
+    enum struct state : u8
+    {
+        headers,
+        normalised,
+        raw,
+    };
+
+    constexpr static szt optional_offset = sizeof(u32) + sizeof(coff::file_header);
+
+    // Bytes of header_ needed to read the section table, 0 if the input can't be a PE.
+    NODISCARD
+    auto
+    header_size() const noexcept -> szt
+    {
+        if (header_.size() < sizeof(dos_header)) {
+            return sizeof(dos_header);
+        }
+
+        const auto* const dos = reinterpret_cast<const dos_header*>(header_.data());
+        const auto        nt  = static_cast<szt>(dos->next_hdr_offset());
+
+        if (!dos->valid() || nt < sizeof(dos_header) || nt > max_header_size) {
+            return 0;
+        }
+
+        if (header_.size() < nt + optional_offset) {
+            return nt + optional_offset;
+        }
+
+        const auto* const file = reinterpret_cast<const coff::file_header*>(header_.data() + nt + sizeof(u32));
+
+        // plan() reads the optional header magic to pick the layout
+        if (file->size_optional_header() < sizeof(u16)) {
+            return 0;
+        }
+
+        const auto end = nt
+            + optional_offset
+            + file->size_optional_header()
+            + file->num_sections() * sizeof(coff::section_header);
+
+        return end <= max_header_size ? end : 0;
+    }
+
+    NODISCARD
+    auto
+    plan() -> bool
+    {
+        // signature and optional header magic are at the same place in both layouts
+        const auto* const img = reinterpret_cast<const image<true>*>(header_.data());
+
+        if (!img->nt_hdr()->valid()) {
+            return false;
+        }
+
+        if (img->is_64_bit()) {
+            return plan(*reinterpret_cast<const image<true>*>(header_.data()));
+        }
+
+        return plan(*reinterpret_cast<const image<false>*>(header_.data()));
+    }
+
+    template<bool X64>
+    NODISCARD
+    auto
+    plan(
+        const image<X64>& img
+    ) -> bool
+    {
+        const auto* const nt      = img.nt_hdr();
+        const auto        nt_ptr  = static_cast<szt>(img.dos_hdr()->next_hdr_offset());
+        const auto        opt_end = nt_ptr + optional_offset + nt->file_hdr().size_optional_header();
+        const auto        offset  = [&](const void* const field) {
+            return static_cast<szt>(static_cast<const u8*>(field) - header_.data());
+        };
+
+        if (offset(&nt->optional_hdr().data_directories()) > opt_end) {
+            return false;
+        }
+
+        // the time stamp follows the machine and section count
+        masks_.push_back({offset(&nt->file_hdr()) + sizeof(u16) * 2, sizeof(u32), mask_kind::zero});
+        masks_.push_back({checksum_offset(header_), sizeof(u32), mask_kind::zero});
+
+        // only data directory entries inside the optional header count
+        const auto entry = [&](const win::directory id) -> const data_directory* {
+            const auto& opt = nt->optional_hdr();
+
+            if (opt.num_data_directories() <= static_cast<u32>(id)) {
+                return nullptr;
+            }
+
+            const auto* const dir = &opt.data_directories().at(id);
+
+            return offset(dir) + sizeof(data_directory) <= opt_end ? dir : nullptr;
+        };
+
+        const auto to_offset = [&](const u32 rva) -> szt {
+            if (rva < nt->optional_hdr().size_headers()) {
+                return rva;
+            }
+
+            const auto* const scn = img.rva_to_section(rva);
+
+            if (scn == nullptr || rva - scn->virtual_address() >= scn->size_raw_data()) {
+                return invalid_offset;
+            }
+
+            return static_cast<szt>(scn->ptr_raw_data()) + (rva - scn->virtual_address());
+        };
+
+        if (const auto* const security = entry(win::directory::security)) {
+            masks_.push_back({offset(security), sizeof(data_directory), mask_kind::zero});
+
+            if (security->present()) {
+                masks_.push_back({security->rva(), security->size(), mask_kind::skip});
+            }
+        }
+
+        if (const auto* const exports = entry(win::directory::exports); exports != nullptr && exports->present()) {
+            if (const auto at = to_offset(exports->rva()); at != invalid_offset) {
+                masks_.push_back({at + sizeof(u32), sizeof(u32), mask_kind::zero});
+            }
+        }
+
+        if (const auto* const debug = entry(win::directory::debug); debug != nullptr && debug->present()) {
+            const auto at    = to_offset(debug->rva());
+            const auto count = std::min<szt>(debug->size() / sizeof(debug_directory), max_debug_entries);
+
+            if (at != invalid_offset && count != 0) {
+                for (szt i{}; i < count; ++i) {
+                    masks_.push_back({at + i * sizeof(debug_directory) + sizeof(u32), sizeof(u32), mask_kind::zero});
+                }
+
+                captures_.push_back({at, std::vector<u8>(count * sizeof(debug_directory)), 0, capture_kind::debug_directory});
+            }
+        }
+
+        sort_masks();
+
+        return true;
+    }
+
+    auto
+    sort_masks() -> void
+    {
+        std::sort(masks_.begin(), masks_.end(), [](const mask& lhs, const mask& rhs) {
+            return lhs.offset < rhs.offset;
+        });
+    }
+
+    // Called once the bytes of `c` are complete, may add masks and captures behind it.
+    auto
+    captured(
+        const capture& c
+    ) -> void
+    {
+        if (c.kind == capture_kind::codeview) {
+            if (bit::load_little<u32>(c.data.data()) == cv_pdb70::magic_value) {
+                // the GUID and the age change with every link
+                masks_.push_back({c.offset + cv_pdb70::guid_offset, cv_pdb70::name_offset - cv_pdb70::guid_offset, mask_kind::zero});
+                sort_masks();
+            }
+
+            return;
+        }
+
+        for (szt i{}; i < c.data.size() / sizeof(debug_directory); ++i) {
+            debug_directory entry;
+
+            std::memcpy(&entry, c.data.data() + i * sizeof(debug_directory), sizeof(entry));
+
+            if (entry.type() == debug_type::codeview
+                && entry.size_raw_data() >= cv_pdb70::name_offset
+                && entry.ptr_raw_data() >= c.offset + c.data.size()
+            ) {
+                captures_.push_back({entry.ptr_raw_data(), std::vector<u8>(sizeof(u32)), 0, capture_kind::codeview});
+            }
+        }
+    }
+
+    auto
+    process(
+        std::span<const u8> chunk
+    ) -> void
+    {
+        if (state_ != state::normalised) {
+            hasher_.update(chunk.data(), chunk.size());
+            position_ += chunk.size();
+            return;
+        }
+
+        const auto end = position_ + chunk.size();
+
+        // captures first, completing one can add masks for bytes of this chunk; a capture is
+        // only added for offsets past the one that created it, so the index loop sees it
+        for (szt i{}; i < captures_.size(); ++i) {
+            auto& c = captures_[i];
+
+            if (c.offset + c.filled < position_ || c.offset + c.filled >= end || c.filled == c.data.size()) {
+                continue;
+            }
+
+            const auto from = c.offset + c.filled - position_;
+            const auto take = std::min(c.data.size() - c.filled, chunk.size() - from);
+
+            std::memcpy(c.data.data() + c.filled, chunk.data() + from, take);
+
+            c.filled += take;
+
+            if (c.filled == c.data.size()) {
+                const auto done = captures_[i];
+
+                captured(done);
+            }
+        }
+
+        std::erase_if(captures_, [&](const capture& c) {
+            return c.filled == c.data.size() || c.offset + c.filled < end;
+        });
+
+        auto cursor = position_;
+
+        for (const auto& m : masks_) {
+            const auto m_end = m.offset + m.size;
+
+            if (m_end <= cursor || m.offset >= end) {
+                continue;
+            }
+
+            if (m.offset > cursor) {
+                hasher_.update(chunk.data() + (cursor - position_), m.offset - cursor);
+                cursor = m.offset;
+            }
+
+            const auto masked = std::min(m_end, end) - cursor;
+
+            if (m.kind == mask_kind::zero) {
+                for (auto left = masked; left != 0;) {
+                    const auto n = std::min(left, zeros.size());
+
+                    hasher_.update(zeros.data(), n);
+
+                    left -= n;
+                }
+            }
+
+            cursor += masked;
+        }
+
+        hasher_.update(chunk.data() + (cursor - position_), end - cursor);
+
+        std::erase_if(masks_, [&](const mask& m) {
+            return m.offset + m.size <= end;
+        });
+
+        position_ = end;
+    }
+
+    constexpr static szt                invalid_offset = static_cast<szt>(-1);
+    constexpr static std::array<u8, 64> zeros{};
+
+    Hash                 hasher_{};
+    std::vector<u8>      header_{};
+    std::vector<mask>    masks_{};
+    std::vector<capture> captures_{};
+    szt                  position_{};
+    state                state_{state::headers};
+    bool                 normalised_{};
+};
+
+// Normalised digest of a whole file in memory, Hash is one of the zen::crypto hashers.
+template<class Hash>
+NODISCARD
+auto
+normalised_digest(
+    const std::span<const u8> file
+) -> typename Hash::digest_type
+{
+    normalised_hasher<Hash> hasher;
+
+    hasher.update(file);
+
+    return hasher.finalize();
+}
+} //namespace zen::win
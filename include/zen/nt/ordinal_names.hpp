@@ -0,0 +1,183 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/string.hpp>
+#include <algorithm>
+#include <span>
+#include <string_view>
+
+namespace zen::win {
+struct ordinal_name
+{
+    u16              ordinal{};
+    std::string_view name;
+};
+
+// Names of the most common ordinal-only exports of ws2_32 and oleaut32. These are a subset of
+// pefile's ordlookup tables, so ordinals missing here come out as "ord<N>" where pefile would
+// print a name. Every table is sorted by ordinal, which is checked at compile time.
+inline constexpr ordinal_name ws2_32_ordinals[]{
+    {1, "accept"},
+    {2, "bind"},
+    {3, "closesocket"},
+    {4, "connect"},
+    {5, "getpeername"},
+    {6, "getsockname"},
+    {7, "getsockopt"},
+    {8, "htonl"},
+    {9, "htons"},
+    {10, "ioctlsocket"},
+    {11, "inet_addr"},
+    {12, "inet_ntoa"},
+    {13, "listen"},
+    {14, "ntohl"},
+    {15, "ntohs"},
+    {16, "recv"},
+    {17, "recvfrom"},
+    {18, "select"},
+    {19, "send"},
+    {20, "sendto"},
+    {21, "setsockopt"},
+    {22, "shutdown"},
+    {23, "socket"},
+    {51, "gethostbyaddr"},
+    {52, "gethostbyname"},
+    {53, "getprotobyname"},
+    {54, "getprotobynumber"},
+    {55, "getservbyname"},
+    {56, "getservbyport"},
+    {57, "gethostname"},
+    {101, "WSAAsyncSelect"},
+    {102, "WSAAsyncGetHostByAddr"},
+    {103, "WSAAsyncGetHostByName"},
+    {104, "WSAAsyncGetProtoByNumber"},
+    {105, "WSAAsyncGetProtoByName"},
+    {106, "WSAAsyncGetServByPort"},
+    {107, "WSAAsyncGetServByName"},
+    {108, "WSACancelAsyncRequest"},
+    {109, "WSASetBlockingHook"},
+    {110, "WSAUnhookBlockingHook"},
+    {111, "WSAGetLastError"},
+    {112, "WSASetLastError"},
+    {113, "WSACancelBlockingCall"},
+    {114, "WSAIsBlocking"},
+    {115, "WSAStartup"},
+    {116, "WSACleanup"},
+    {151, "__WSAFDIsSet"},
+    {500, "WEP"},
+};
+
+inline constexpr ordinal_name oleaut32_ordinals[]{
+    {2, "SysAllocString"},
+    {3, "SysReAllocString"},
+    {4, "SysAllocStringLen"},
+    {5, "SysReAllocStringLen"},
+    {6, "SysFreeString"},
+    {7, "SysStringLen"},
+    {8, "VariantInit"},
+    {9, "VariantClear"},
+    {10, "VariantCopy"},
+    {11, "VariantCopyInd"},
+    {12, "VariantChangeType"},
+    {13, "VariantTimeToDosDateTime"},
+    {14, "DosDateTimeToVariantTime"},
+    {15, "SafeArrayCreate"},
+    {16, "SafeArrayDestroy"},
+    {17, "SafeArrayGetDim"},
+    {18, "SafeArrayGetElemsize"},
+    {19, "SafeArrayGetUBound"},
+    {20, "SafeArrayGetLBound"},
+    {21, "SafeArrayLock"},
+    {22, "SafeArrayUnlock"},
+    {23, "SafeArrayAccessData"},
+    {24, "SafeArrayUnaccessData"},
+    {25, "SafeArrayGetElement"},
+    {26, "SafeArrayPutElement"},
+    {27, "SafeArrayCopy"},
+    {28, "DispGetParam"},
+    {29, "DispGetIDsOfNames"},
+    {30, "DispInvoke"},
+    {31, "CreateDispTypeInfo"},
+    {32, "CreateStdDispatch"},
+    {33, "RegisterActiveObject"},
+    {34, "RevokeActiveObject"},
+    {35, "GetActiveObject"},
+    {36, "SafeArrayAllocDescriptor"},
+    {37, "SafeArrayAllocData"},
+    {38, "SafeArrayDestroyDescriptor"},
+    {39, "SafeArrayDestroyData"},
+    {40, "SafeArrayRedim"},
+    {41, "SafeArrayAllocDescriptorEx"},
+    {42, "SafeArrayCreateEx"},
+    {43, "SafeArrayCreateVectorEx"},
+    {44, "SafeArraySetRecordInfo"},
+    {45, "SafeArrayGetRecordInfo"},
+    {147, "VariantChangeTypeEx"},
+    {148, "SafeArrayPtrOfIndex"},
+    {149, "SysStringByteLen"},
+    {150, "SysAllocStringByteLen"},
+};
+
+static_assert(std::ranges::is_sorted(ws2_32_ordinals, {}, &ordinal_name::ordinal));
+static_assert(std::ranges::is_sorted(oleaut32_ordinals, {}, &ordinal_name::ordinal));
+
+// Table for an import module name including its extension, e.g. "WS2_32.dll".
+NODISCARD
+constexpr
+auto
+ordinal_table(
+    const std::string_view module
+) noexcept -> std::span<const ordinal_name>
+{
+    if (equals_ignore_case(module, "ws2_32.dll") || equals_ignore_case(module, "wsock32.dll")) {
+        return ws2_32_ordinals;
+    }
+
+    if (equals_ignore_case(module, "oleaut32.dll")) {
+        return oleaut32_ordinals;
+    }
+
+    return {};
+}
+
+// Empty if the ordinal isn't known.
+NODISCARD
+constexpr
+auto
+ordinal_to_name(
+    const std::string_view module,
+    const u16              ordinal
+) noexcept -> std::string_view
+{
+    const auto table = ordinal_table(module);
+    const auto it    = std::ranges::lower_bound(table, ordinal, {}, &ordinal_name::ordinal);
+
+    return it != table.end() && it->ordinal == ordinal ? it->name : std::string_view{};
+}
+
+static_assert(ordinal_to_name("WS2_32.DLL", 115) == "WSAStartup");
+static_assert(ordinal_to_name("kernel32.dll", 115).empty());
+} //namespace zen::win
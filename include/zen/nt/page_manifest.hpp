@@ -0,0 +1,628 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/parallel.hpp>
+#include <zen/crypto/sha256.hpp>
+#include <zen/nt/directories/relocs.hpp>
+#include <zen/nt/image.hpp>
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace zen::win {
+// Per page hashes of the memory layout of every section, arranged as a Merkle tree (one subtree
+// per section). Bytes that legitimately differ once an image is loaded, relocation slots and the
+// IAT, are hashed as zeros, so a loaded module can be checked page by page against a manifest
+// built from its file.
+class page_manifest
+{
+public:
+    using digest_type = crypto::sha256::digest_type;
+
+    constexpr static u32 page_size = 0x1000;
+    constexpr static u32 magic     = 0x464D505A; // "ZPMF"
+    constexpr static u32 version   = 1;
+
+    struct section
+    {
+        u32         rva{};
+        u32         size{};
+        u32         first_page{};
+        u32         num_pages{};
+        digest_type root{};
+    };
+
+    page_manifest() = default;
+
+    // Builds the manifest of the file layout image `img`, raw data past `file_size` is hashed as
+    // zeros.
+    template<bool X64>
+    NODISCARD
+    static
+    auto
+    build(
+        const image<X64>& img,
+        const szt         file_size,
+        const u32         threads = 0
+    ) -> page_manifest
+    {
+        page_manifest manifest;
+
+        const auto* const file = reinterpret_cast<const u8*>(&img);
+        std::vector<masked_range> masked;
+
+        collect_masks(img, file_size, masked);
+
+        std::vector<const coff::section_header*> headers;
+
+        for (const auto& scn : img.nt_hdr()->template sections<true>()) {
+            const auto size = scn.virtual_size() != 0 ? scn.virtual_size() : scn.size_raw_data();
+
+            if (size == 0) {
+                continue;
+            }
+
+            manifest.sections_.push_back({
+                .rva        = scn.virtual_address(),
+                .size       = size,
+                .first_page = static_cast<u32>(manifest.pages_.size()),
+                .num_pages  = (size + page_size - 1) / page_size,
+            });
+
+            headers.push_back(&scn);
+
+            for (u32 i{}; i < manifest.sections_.back().num_pages; ++i) {
+                const auto rva = scn.virtual_address() + i * page_size;
+
+                manifest.pages_.push_back({
+                    .rva        = rva,
+                    .length     = std::min(page_size, size - i * page_size),
+                    .mask_first = static_cast<u32>(manifest.masks_.size()),
+                    .mask_count = 0,
+                });
+
+                manifest.add_masks(masked, manifest.pages_.back());
+            }
+        }
+
+        manifest.leaves_.resize(manifest.pages_.size());
+
+        parallel_for(manifest.sections_.size(), [&](const szt index) {
+            const auto& scn       = manifest.sections_[index];
+            const auto* const hdr = headers[index];
+            const auto  raw_ptr   = hdr->ptr_raw_data();
+            const auto  raw_size  = raw_ptr != 0 && raw_ptr < file_size
+                ? static_cast<u32>(std::min<szt>(hdr->size_raw_data(), file_size - raw_ptr))
+                : 0u;
+
+            u8 buffer[page_size];
+
+            for (u32 i{}; i < scn.num_pages; ++i) {
+                const auto& entry  = manifest.pages_[scn.first_page + i];
+                const auto  offset = i * page_size;
+                const auto  raw    = offset < raw_size ? std::min(entry.length, raw_size - offset) : 0u;
+
+                std::memcpy(buffer, file + raw_ptr + offset, raw);
+                std::memset(buffer + raw, 0, page_size - raw);
+
+                manifest.leaves_[scn.first_page + i] = manifest.hash_page(buffer, entry);
+            }
+        }, threads);
+
+        manifest.update_roots();
+
+        return manifest;
+    }
+
+    NODISCARD
+    auto
+    valid() const noexcept -> bool
+    {
+        return !pages_.empty();
+    }
+
+    NODISCARD
+    auto
+    root() const noexcept -> const digest_type&
+    {
+        return root_;
+    }
+
+    NODISCARD
+    auto
+    sections() const noexcept -> std::span<const section>
+    {
+        return sections_;
+    }
+
+    NODISCARD
+    auto
+    num_pages() const noexcept -> szt
+    {
+        return pages_.size();
+    }
+
+    NODISCARD
+    auto
+    leaf(
+        const szt index
+    ) const noexcept -> const digest_type&
+    {
+        return leaves_[index];
+    }
+
+    // Checks the page containing `rva` of a memory layout image loaded at `base`. Addresses
+    // outside every section have no manifest entry and fail.
+    NODISCARD
+    auto
+    verify_page(
+        const u8* const base,
+        const u32       rva
+    ) const noexcept -> bool
+    {
+        const auto* const entry = find(rva);
+
+        return entry && hash_page(base + entry->rva, *entry) == leaves_[static_cast<szt>(entry - pages_.data())];
+    }
+
+    // Re-hashes the pages containing `rvas`, e.g. the ones a dirty page tracker reports, and
+    // returns the page rvas that don't match.
+    NODISCARD
+    auto
+    verify(
+        const u8* const           base,
+        const std::span<const u32> rvas
+    ) const -> std::vector<u32>
+    {
+        std::vector<u32> result;
+
+        for (const auto rva : rvas) {
+            if (!verify_page(base, rva)) {
+                result.push_back(rva & ~(page_size - 1));
+            }
+        }
+
+        return result;
+    }
+
+    NODISCARD
+    auto
+    verify_all(
+        const u8* const base,
+        const u32       threads = 0
+    ) const -> std::vector<u32>
+    {
+        std::vector<u8> failed(pages_.size());
+
+        parallel_for(pages_.size(), [&](const szt index) {
+            failed[index] = hash_page(base + pages_[index].rva, pages_[index]) != leaves_[index];
+        }, threads);
+
+        std::vector<u32> result;
+
+        for (szt i{}; i < pages_.size(); ++i) {
+            if (failed[i]) {
+                result.push_back(pages_[i].rva);
+            }
+        }
+
+        return result;
+    }
+
+    // Layout: header, section table, mask count per page, masks, leaves. Everything is little
+    // endian, the roots are recomputed when the manifest is loaded.
+    NODISCARD
+    auto
+    serialize() const -> std::vector<u8>
+    {
+        std::vector<u8> out;
+
+        out.reserve(
+            sizeof(u32) * 5
+            + sections_.size() * sizeof(u32) * 4
+            + pages_.size() * (sizeof(u16) + sizeof(digest_type))
+            + masks_.size() * sizeof(u16) * 2
+        );
+
+        write<u32>(out, magic);
+        write<u32>(out, version);
+        write<u32>(out, static_cast<u32>(sections_.size()));
+        write<u32>(out, static_cast<u32>(pages_.size()));
+        write<u32>(out, static_cast<u32>(masks_.size()));
+
+        for (const auto& scn : sections_) {
+            write<u32>(out, scn.rva);
+            write<u32>(out, scn.size);
+            write<u32>(out, scn.first_page);
+            write<u32>(out, scn.num_pages);
+        }
+
+        for (const auto& entry : pages_) {
+            write<u16>(out, entry.mask_count);
+        }
+
+        for (const auto& entry : masks_) {
+            write<u16>(out, entry.offset);
+            write<u16>(out, entry.length);
+        }
+
+        for (const auto& leaf : leaves_) {
+            out.insert(out.end(), leaf.begin(), leaf.end());
+        }
+
+        return out;
+    }
+
+    NODISCARD
+    static
+    auto
+    deserialize(
+        std::span<const u8> in
+    ) -> page_manifest
+    {
+        page_manifest manifest;
+
+        u32 header[5]{};
+
+        for (auto& value : header) {
+            if (!read(in, value)) {
+                return {};
+            }
+        }
+
+        const auto [file_magic, file_version, num_sections, num_pages, num_masks] = header;
+
+        if (
+            file_magic != magic
+            || file_version != version
+            || in.size() < static_cast<u64>(num_sections) * 16 + static_cast<u64>(num_pages) * 34 + static_cast<u64>(num_masks) * 4
+        ) {
+            return {};
+        }
+
+        u32 expected_page{};
+
+        for (u32 i{}; i < num_sections; ++i) {
+            section scn{};
+
+            read(in, scn.rva);
+            read(in, scn.size);
+            read(in, scn.first_page);
+            read(in, scn.num_pages);
+
+            if (
+                scn.first_page != expected_page
+                || scn.num_pages != (static_cast<u64>(scn.size) + page_size - 1) / page_size
+                || static_cast<u64>(scn.first_page) + scn.num_pages > num_pages
+            ) {
+                return {};
+            }
+
+            expected_page += scn.num_pages;
+
+            manifest.sections_.push_back(scn);
+
+            for (u32 j{}; j < scn.num_pages; ++j) {
+                manifest.pages_.push_back({
+                    .rva        = scn.rva + j * page_size,
+                    .length     = std::min(page_size, scn.size - j * page_size),
+                    .mask_first = 0,
+                    .mask_count = 0,
+                });
+            }
+        }
+
+        if (expected_page != num_pages) {
+            return {};
+        }
+
+        u32 mask_first{};
+
+        for (auto& entry : manifest.pages_) {
+            read(in, entry.mask_count);
+
+            entry.mask_first = mask_first;
+            mask_first     += entry.mask_count;
+        }
+
+        if (mask_first != num_masks) {
+            return {};
+        }
+
+        manifest.masks_.resize(num_masks);
+
+        for (auto& entry : manifest.masks_) {
+            read(in, entry.offset);
+            read(in, entry.length);
+        }
+
+        for (const auto& target : manifest.pages_) {
+            for (u32 i{}; i < target.mask_count; ++i) {
+                const auto& entry = manifest.masks_[target.mask_first + i];
+
+                if (static_cast<u32>(entry.offset) + entry.length > target.length) {
+                    return {};
+                }
+            }
+        }
+
+        manifest.leaves_.resize(num_pages);
+
+        for (auto& leaf : manifest.leaves_) {
+            std::memcpy(leaf.data(), in.data(), leaf.size());
+
+            in = in.subspan(leaf.size());
+        }
+
+        manifest.update_roots();
+
+        return manifest;
+    }
+
+private:
+    struct mask
+    {
+        u16 offset{};
+        u16 length{};
+    };
+
+    struct masked_range
+    {
+        u32 rva{};
+        u32 size{};
+    };
+
+    struct page
+    {
+        u32 rva{};
+        u32 length{};
+        u32 mask_first{};
+        u16 mask_count{};
+    };
+
+    template<bool X64>
+    static
+    auto
+    collect_masks(
+        const image<X64>&          img,
+        const szt                  file_size,
+        std::vector<masked_range>& ranges
+    ) -> void
+    {
+        const auto* const file = reinterpret_cast<const u8*>(&img);
+
+        if (const auto* const dir = img.directory(directory::basereloc)) {
+            const auto* const data = img.template rva_to_ptr<u8>(dir->rva(), dir->size());
+
+            // the directory has to be backed by the file
+            if (data && static_cast<szt>(data - file) + dir->size() <= file_size) {
+                for (szt offset{}; offset + sizeof(u32) * 2 <= dir->size();) {
+                    const auto* const block = reinterpret_cast<const reloc_block*>(data + offset);
+
+                    if (block->size_block() < sizeof(u32) * 2 || offset + block->size_block() > dir->size()) {
+                        break;
+                    }
+
+                    for (const auto& entry : *block) {
+                        if (const auto width = reloc_width(entry.type()); width != 0) {
+                            ranges.push_back({block->base_rva() + entry.offset(), static_cast<u32>(width)});
+                        }
+                    }
+
+                    offset += block->size_block();
+                }
+            }
+        }
+
+        // the loader writes the resolved imports over the IAT
+        if (const auto* const dir = img.directory(directory::iat)) {
+            for (u32 offset{}; offset < dir->size(); offset += sizeof(u64)) {
+                ranges.push_back({dir->rva() + offset, std::min<u32>(sizeof(u64), dir->size() - offset)});
+            }
+        }
+
+        std::sort(ranges.begin(), ranges.end(), [](const masked_range& lhs, const masked_range& rhs) {
+            return lhs.rva < rhs.rva;
+        });
+    }
+
+    auto
+    add_masks(
+        const std::vector<masked_range>& ranges,
+        page&                            target
+    ) -> void
+    {
+        const auto begin = static_cast<u64>(target.rva);
+        const auto end   = begin + target.length;
+
+        // ranges are sorted by start and at most 8 bytes long, so anything starting up to 8 bytes
+        // before the page can still reach into it
+        auto it = std::lower_bound(ranges.begin(), ranges.end(), begin, [](const masked_range& range, const u64 rva) {
+            return static_cast<u64>(range.rva) + sizeof(u64) <= rva;
+        });
+
+        for (; it != ranges.end() && it->rva < end; ++it) {
+            const auto from = std::max<u64>(it->rva, begin);
+            const auto to   = std::min<u64>(static_cast<u64>(it->rva) + it->size, end);
+
+            if (from >= to) {
+                continue;
+            }
+
+            // merge touching slots, a fully relocated table becomes a single entry
+            if (target.mask_count != 0) {
+                auto& last = masks_.back();
+
+                if (begin + last.offset + last.length >= from) {
+                    last.length = static_cast<u16>(std::max<u64>(begin + last.offset + last.length, to) - begin - last.offset);
+                    continue;
+                }
+            }
+
+            masks_.push_back({static_cast<u16>(from - begin), static_cast<u16>(to - from)});
+
+            ++target.mask_count;
+        }
+    }
+
+    NODISCARD
+    auto
+    hash_page(
+        const u8* const data,
+        const page&     target
+    ) const noexcept -> digest_type
+    {
+        constexpr static u8 zeros[page_size]{};
+        constexpr static u8 leaf_prefix = 0;
+
+        crypto::sha256 hasher;
+        u32            cursor{};
+
+        hasher.update(&leaf_prefix, sizeof(leaf_prefix));
+
+        for (u32 i{}; i < target.mask_count; ++i) {
+            const auto& entry = masks_[target.mask_first + i];
+
+            hasher.update(data + cursor, entry.offset - cursor);
+            hasher.update(zeros, entry.length);
+
+            cursor = entry.offset + entry.length;
+        }
+
+        hasher.update(data + cursor, target.length - cursor);
+
+        return hasher.finalize();
+    }
+
+    NODISCARD
+    static
+    auto
+    merkle_root(
+        std::vector<digest_type> level
+    ) -> digest_type
+    {
+        constexpr static u8 node_prefix = 1;
+
+        if (level.empty()) {
+            return {};
+        }
+
+        while (level.size() > 1) {
+            szt out{};
+
+            for (szt i{}; i < level.size(); i += 2) {
+                if (i + 1 == level.size()) {
+                    level[out++] = level[i];
+                    continue;
+                }
+
+                crypto::sha256 hasher;
+
+                hasher.update(&node_prefix, sizeof(node_prefix));
+                hasher.update(level[i]);
+                hasher.update(level[i + 1]);
+
+                level[out++] = hasher.finalize();
+            }
+
+            level.resize(out);
+        }
+
+        return level.front();
+    }
+
+    auto
+    update_roots() -> void
+    {
+        std::vector<digest_type> roots;
+
+        for (auto& scn : sections_) {
+            scn.root = merkle_root({
+                leaves_.begin() + scn.first_page,
+                leaves_.begin() + scn.first_page + scn.num_pages
+            });
+
+            roots.push_back(scn.root);
+        }
+
+        root_ = merkle_root(std::move(roots));
+    }
+
+    NODISCARD
+    auto
+    find(
+        const u32 rva
+    ) const noexcept -> const page*
+    {
+        // sections are usually sorted, but nothing forces them to be
+        for (const auto& scn : sections_) {
+            if (rva >= scn.rva && rva - scn.rva < scn.size) {
+                return &pages_[scn.first_page + (rva - scn.rva) / page_size];
+            }
+        }
+
+        return nullptr;
+    }
+
+    template<class T>
+    static
+    auto
+    write(
+        std::vector<u8>& out,
+        const T          value
+    ) -> void
+    {
+        const auto little = bit::little(value);
+        const auto* bytes = reinterpret_cast<const u8*>(&little);
+
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<class T>
+    static
+    auto
+    read(
+        std::span<const u8>& in,
+        T&                   value
+    ) noexcept -> bool
+    {
+        if (in.size() < sizeof(T)) {
+            return false;
+        }
+
+        value = bit::load_little<T>(in.data());
+        in    = in.subspan(sizeof(T));
+
+        return true;
+    }
+
+    std::vector<section>     sections_;
+    std::vector<page>        pages_;
+    std::vector<mask>        masks_;
+    std::vector<digest_type> leaves_;
+    digest_type              root_{};
+};
+} //namespace zen::win
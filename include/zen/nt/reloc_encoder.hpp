@@ -0,0 +1,213 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/nt/directories/relocs.hpp>
+#include <array>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace zen::win {
+struct reloc_fixup
+{
+    u32        rva{};
+    reloc_type type{};
+};
+
+// LSD radix sort of `fixups` by RVA and then type, which puts repeated (RVA, type) pairs next to
+// each other. The digits are the 4-bit type, the 12-bit page offset, the 12 bits above it and
+// the top byte, so images below 16 MB with a single relocation type need two passes. All
+// histograms come from a single read and passes whose digit is the same for every entry are
+// skipped. `scratch` needs as many entries as `fixups`; the result always ends up in `fixups`.
+inline
+auto
+sort_relocs(
+    const std::span<reloc_fixup> fixups,
+    const std::span<reloc_fixup> scratch
+) noexcept -> void
+{
+    if (fixups.size() < 2 || scratch.size() < fixups.size()) {
+        return;
+    }
+
+    // the first pass runs over the type, the others over the RVA
+    constexpr std::array<u32, 4> shifts{0, 0, 12, 24};
+    constexpr std::array<u32, 4> masks{0xF, 0xFFF, 0xFFF, 0xFF};
+
+    const auto key = [](const reloc_fixup& fixup, const szt pass) -> u32 {
+        return pass == 0 ? std::to_underlying(fixup.type) : fixup.rva;
+    };
+
+    std::array<std::array<u32, 0x1000>, 4> counts{};
+
+    for (const auto& fixup : fixups) {
+        ++counts[0][std::to_underlying(fixup.type) & 0xF];
+        ++counts[1][fixup.rva & 0xFFF];
+        ++counts[2][(fixup.rva >> 12) & 0xFFF];
+        ++counts[3][fixup.rva >> 24];
+    }
+
+    auto* src = fixups.data();
+    auto* dst = scratch.data();
+
+    for (szt pass{}; pass < shifts.size(); ++pass) {
+        auto&      count = counts[pass];
+        const auto shift = shifts[pass];
+        const auto mask  = masks[pass];
+
+        if (count[(key(src[0], pass) >> shift) & mask] == fixups.size()) {
+            continue;
+        }
+
+        u32 offset{};
+
+        for (u32 digit{}; digit <= mask; ++digit) {
+            const auto n = count[digit];
+
+            count[digit] = offset;
+            offset      += n;
+        }
+
+        for (szt i{}; i < fixups.size(); ++i) {
+            dst[count[(key(src[i], pass) >> shift) & mask]++] = src[i];
+        }
+
+        std::swap(src, dst);
+    }
+
+    if (src != fixups.data()) {
+        std::memcpy(fixups.data(), src, fixups.size() * sizeof(reloc_fixup));
+    }
+}
+
+// Bytes the directory for the sorted `fixups` takes, repeated (RVA, type) pairs count once.
+NODISCARD
+inline
+auto
+reloc_directory_size(
+    const std::span<const reloc_fixup> fixups
+) noexcept -> szt
+{
+    szt size{};
+
+    for (szt i{}; i < fixups.size();) {
+        const auto page = fixups[i].rva & ~0xFFFu;
+        szt        entries{};
+
+        for (auto prev = i; i < fixups.size() && (fixups[i].rva & ~0xFFFu) == page; prev = i++) {
+            entries += i == prev || fixups[i].rva != fixups[prev].rva || fixups[i].type != fixups[prev].type;
+        }
+
+        size += sizeof(u32) * 2 + ((entries + 1) & ~szt{1}) * sizeof(reloc_entry);
+    }
+
+    return size;
+}
+
+// Encodes the sorted `fixups` as one block per 4K page, each padded to a 4-byte boundary with a
+// based_absolute entry. Returns the bytes written, 0 if `out` is smaller than
+// reloc_directory_size(). based_high_adj needs a second parameter slot and isn't representable.
+NODISCARD
+inline
+auto
+encode_relocs(
+    const std::span<const reloc_fixup> fixups,
+    const std::span<u8>                out
+) noexcept -> szt
+{
+    auto*       at  = out.data();
+    const auto* end = out.data() + out.size();
+
+    for (szt i{}; i < fixups.size();) {
+        const auto page  = fixups[i].rva & ~0xFFFu;
+        auto*      block = at;
+
+        if (end - at < static_cast<std::ptrdiff_t>(sizeof(u32) * 2)) {
+            return 0;
+        }
+
+        at += sizeof(u32) * 2;
+
+        for (auto prev = i; i < fixups.size() && (fixups[i].rva & ~0xFFFu) == page; prev = i++) {
+            if (i != prev && fixups[i].rva == fixups[prev].rva && fixups[i].type == fixups[prev].type) {
+                continue;
+            }
+
+            if (end - at < static_cast<std::ptrdiff_t>(sizeof(u16))) {
+                return 0;
+            }
+
+            // type in the top 4 bits, page offset below, as in reloc_entry
+            const auto entry = bit::little(static_cast<u16>((std::to_underlying(fixups[i].type) << 12) | (fixups[i].rva & 0xFFF)));
+
+            std::memcpy(at, &entry, sizeof(entry));
+            at += sizeof(entry);
+        }
+
+        if (static_cast<szt>(at - block) % sizeof(u32) != 0) {
+            if (end - at < static_cast<std::ptrdiff_t>(sizeof(u16))) {
+                return 0;
+            }
+
+            std::memset(at, 0, sizeof(u16));
+            at += sizeof(u16);
+        }
+
+        const std::array header{bit::little(page), bit::little(static_cast<u32>(at - block))};
+
+        std::memcpy(block, header.data(), sizeof(header));
+    }
+
+    return static_cast<szt>(at - out.data());
+}
+
+// Keeps the scratch space between calls, so encoding many directories doesn't allocate once
+// the buffers have grown to the largest input.
+class reloc_encoder
+{
+public:
+    // Sorts `fixups` in place and replaces the contents of `out` with the encoded directory.
+    auto
+    encode(
+        const std::span<reloc_fixup> fixups,
+        std::vector<u8>&             out
+    ) -> void
+    {
+        if (scratch_.size() < fixups.size()) {
+            scratch_.resize(fixups.size());
+        }
+
+        sort_relocs(fixups, scratch_);
+
+        out.resize(reloc_directory_size(fixups));
+
+        (void)encode_relocs(fixups, out);
+    }
+
+private:
+    std::vector<reloc_fixup> scratch_;
+};
+} //namespace zen::win
@@ -0,0 +1,335 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/fnv.hpp>
+#include <zen/nt/dos_header.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <span>
+#include <vector>
+#if defined(ZEN_TARGET_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define ZEN_RICH_SSE2 1
+#   include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   define ZEN_RICH_NEON 1
+#   include <arm_neon.h>
+#endif
+
+namespace zen::detail {
+// Decodes `words` little endian dwords at `src` with the Rich XOR key.
+inline
+auto
+rich_decode(
+    const u8* const src,
+    const u32       key,
+    u32* const      dst,
+    const szt       words
+) noexcept -> void
+{
+    szt i{};
+
+#if defined(ZEN_RICH_SSE2)
+    const auto mask = _mm_set1_epi32(static_cast<int>(key));
+
+    for (; i + 4 <= words; i += 4) {
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(dst + i),
+            _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * sizeof(u32))), mask)
+        );
+    }
+#elif defined(ZEN_RICH_NEON)
+    const auto mask = vdupq_n_u32(key);
+
+    for (; i + 4 <= words; i += 4) {
+        vst1q_u32(dst + i, veorq_u32(vld1q_u32(reinterpret_cast<const u32*>(src + i * sizeof(u32))), mask));
+    }
+#endif
+
+    for (; i < words; ++i) {
+        dst[i] = bit::load_little<u32>(src + i * sizeof(u32)) ^ key;
+    }
+}
+} //namespace zen::detail
+
+namespace zen::win {
+struct rich_entry
+{
+    u16 build{};
+    u16 product{};
+    u32 count{};
+
+    NODISCARD
+    constexpr
+    auto
+    comp_id() const noexcept -> u32
+    {
+        return static_cast<u32>(product) << 16 | build;
+    }
+};
+
+// The undocumented "Rich" header the MSVC linker places in the DOS stub:
+//
+//   "DanS" ^ key, 3x (0 ^ key), n x (comp.id ^ key, count ^ key), "Rich", key
+//
+// The decoder works in place on the file bytes between the DOS header and e_lfanew, nothing is
+// copied out of the stub.
+class rich_header
+{
+public:
+    constexpr static u32 signature_dans = 0x536E6144; // "DanS"
+    constexpr static u32 signature_rich = 0x68636952; // "Rich"
+
+    constexpr
+    rich_header() noexcept = default;
+
+    // `file` has to cover at least the headers, e_lfanew is checked against it.
+    explicit
+    rich_header(
+        const std::span<const u8> file
+    ) noexcept
+    {
+        if (file.size() < sizeof(dos_header)) {
+            return;
+        }
+
+        const auto lfa = reinterpret_cast<const dos_header*>(file.data())->next_hdr_offset();
+
+        if (lfa <= 0 || static_cast<szt>(lfa) > file.size()) {
+            return;
+        }
+
+        decode(file.data(), static_cast<u32>(lfa));
+    }
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return data_ != nullptr;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    key() const noexcept -> u32
+    {
+        return key_;
+    }
+
+    // File offset of the "DanS" marker.
+    NODISCARD
+    constexpr
+    auto
+    offset() const noexcept -> u32
+    {
+        return begin_;
+    }
+
+    // Size from "DanS" up to and including the key.
+    NODISCARD
+    constexpr
+    auto
+    size() const noexcept -> u32
+    {
+        return valid() ? end_ + sizeof(u32) * 2 - begin_ : 0;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    checksum() const noexcept -> u32
+    {
+        return checksum_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    checksum_valid() const noexcept -> bool
+    {
+        return valid() && checksum_ == key_;
+    }
+
+    // FNV-1a over the decoded comp.id/count pairs in file order. Unlike the key it doesn't
+    // depend on the rest of the DOS stub or e_lfanew.
+    NODISCARD
+    constexpr
+    auto
+    fingerprint() const noexcept -> u64
+    {
+        return fingerprint_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    num_entries() const noexcept -> szt
+    {
+        return valid() ? (end_ - entries_begin()) / (sizeof(u32) * 2) : 0;
+    }
+
+    NODISCARD
+    auto
+    entries() const -> std::vector<rich_entry>
+    {
+        std::vector<rich_entry> result;
+
+        result.reserve(num_entries());
+
+        for_each_entry([&result](const u32 comp_id, const u32 count) {
+            result.push_back({
+                .build   = static_cast<u16>(comp_id & 0xFFFF),
+                .product = static_cast<u16>(comp_id >> 16),
+                .count   = count,
+            });
+        });
+
+        return result;
+    }
+
+private:
+    NODISCARD
+    constexpr
+    auto
+    entries_begin() const noexcept -> u32
+    {
+        return begin_ + sizeof(u32) * 4;
+    }
+
+    template<class Fn>
+    auto
+    for_each_entry(
+        Fn&& fn
+    ) const noexcept -> void
+    {
+        constexpr szt chunk = 64;
+
+        u32 words[chunk];
+
+        for (auto offset = entries_begin(); offset < end_;) {
+            const auto count = std::min<szt>(chunk, (end_ - offset) / sizeof(u32));
+
+            detail::rich_decode(data_ + offset, key_, words, count);
+
+            for (szt i{}; i + 1 < count; i += 2) {
+                fn(words[i], words[i + 1]);
+            }
+
+            offset += static_cast<u32>(count * sizeof(u32));
+        }
+    }
+
+    auto
+    decode(
+        const u8* const data,
+        const u32       limit
+    ) noexcept -> void
+    {
+        // both markers are dword aligned and live between the DOS header and the NT headers
+        u32 rich{};
+
+        for (auto offset = (limit & ~3u); offset >= sizeof(dos_header) + sizeof(u32); offset -= sizeof(u32)) {
+            if (offset + sizeof(u32) * 2 <= limit && bit::load_little<u32>(data + offset) == signature_rich) {
+                rich = offset;
+                break;
+            }
+        }
+
+        if (rich == 0) {
+            return;
+        }
+
+        const auto key = bit::load_little<u32>(data + rich + sizeof(u32));
+        u32        dans{};
+
+        for (auto offset = rich; offset >= sizeof(dos_header) + sizeof(u32);) {
+            offset -= sizeof(u32);
+
+            if ((bit::load_little<u32>(data + offset) ^ key) == signature_dans) {
+                dans = offset;
+                break;
+            }
+        }
+
+        if (dans == 0 || rich - dans < sizeof(u32) * 4 || (rich - dans) % (sizeof(u32) * 2) != 0) {
+            return;
+        }
+
+        u32 padding[3];
+
+        detail::rich_decode(data + dans + sizeof(u32), key, padding, 3);
+
+        if (padding[0] != 0 || padding[1] != 0 || padding[2] != 0) {
+            return;
+        }
+
+        data_  = data;
+        begin_ = dans;
+        end_   = rich;
+        key_   = key;
+
+        // the checksum covers the stub in front of the header, minus e_lfanew
+        auto checksum = dans;
+
+        for (u32 i{}; i < dans; ++i) {
+            if (i < 0x3C || i >= 0x40) {
+                checksum += std::rotl(static_cast<u32>(data[i]), static_cast<int>(i % 32));
+            }
+        }
+
+        auto fingerprint = fnv<u64>::offset_basis;
+
+        for_each_entry([&](const u32 comp_id, const u32 count) {
+            checksum += std::rotl(comp_id, static_cast<int>(count % 32));
+
+            const std::array words{bit::little(comp_id), bit::little(count)};
+
+            fingerprint = fnv<u64>::bytes({reinterpret_cast<const u8*>(words.data()), sizeof(words)}, fingerprint);
+        });
+
+        checksum_    = checksum;
+        fingerprint_ = fingerprint;
+    }
+
+    const u8* data_{};
+    u32       begin_{};
+    u32       end_{};
+    u32       key_{};
+    u32       checksum_{};
+    u64       fingerprint_{};
+};
+} //namespace zen::win
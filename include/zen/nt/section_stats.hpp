@@ -0,0 +1,275 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/bit.hpp>
+#include <zen/coff/section_header.hpp>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace zen::detail {
+// Adds the byte counts of [data, data + size) onto `hist`. Spreading consecutive bytes over
+// several tables breaks the store-to-load dependency a single table has on runs of the same
+// value, which is exactly what padding and compressed data look like.
+inline
+auto
+byte_histogram(
+    const u8* const data,
+    const szt       size,
+    u32* const      hist
+) noexcept -> void
+{
+    u32 tables[4][256]{};
+    szt i{};
+
+    for (; i + 8 <= size; i += 8) {
+        u64 word;
+
+        std::memcpy(&word, data + i, sizeof(word));
+
+        ++tables[0][static_cast<u8>(word)];
+        ++tables[1][static_cast<u8>(word >> 8)];
+        ++tables[2][static_cast<u8>(word >> 16)];
+        ++tables[3][static_cast<u8>(word >> 24)];
+        ++tables[0][static_cast<u8>(word >> 32)];
+        ++tables[1][static_cast<u8>(word >> 40)];
+        ++tables[2][static_cast<u8>(word >> 48)];
+        ++tables[3][static_cast<u8>(word >> 56)];
+    }
+
+    for (; i < size; ++i) {
+        ++tables[0][data[i]];
+    }
+
+    for (szt b{}; b < 256; ++b) {
+        hist[b] += tables[0][b] + tables[1][b] + tables[2][b] + tables[3][b];
+    }
+}
+} //namespace zen::detail
+
+namespace zen::win {
+using byte_histogram = std::array<u32, 256>;
+
+// Shannon entropy in bits per byte, 0 for an empty histogram.
+NODISCARD
+inline
+auto
+shannon_entropy(
+    const byte_histogram& hist
+) noexcept -> double
+{
+    u64    total{};
+    double sum{};
+
+    for (const auto count : hist) {
+        if (count != 0) {
+            total += count;
+            sum   += count * std::log2(static_cast<double>(count));
+        }
+    }
+
+    return total == 0 ? 0.0 : std::log2(static_cast<double>(total)) - sum / static_cast<double>(total);
+}
+
+struct section_stats
+{
+    const coff::section_header* section{};
+    byte_histogram              histogram{};
+    double                      entropy{};
+    // entropy of every full window, in file order
+    std::vector<float>          windows;
+
+    NODISCARD
+    auto
+    max_window_entropy() const noexcept -> float
+    {
+        float result{};
+
+        for (const auto value : windows) {
+            result = std::max(value, result);
+        }
+
+        return result;
+    }
+};
+
+// Computes the byte histogram and entropy of a block of data plus the entropy of every
+// `window` sized block starting at multiples of `stride`. The entropy of a window is
+// log2(window) - sum(c * log2(c)) / window. The counts and that sum are carried from one window
+// to the next and only the bytes that leave and enter it update them, c*log2(c) is looked up
+// from a table built once per analyzer. The sum is kept in 32.32 fixed point so the updates are
+// integer adds that don't drift.
+class section_analyzer
+{
+public:
+    explicit
+    section_analyzer(
+        const u32 window = 1024,
+        const u32 stride = 0
+    )
+        : window_{ std::max(window, 1u) }
+        , stride_{ stride == 0 ? window_ : stride }
+        , terms_(window_ + 1)
+    {
+        for (u32 i{1}; i <= window_; ++i) {
+            terms_[i] = static_cast<u64>(std::llround(i * std::log2(static_cast<double>(i)) * fixed_one));
+        }
+    }
+
+    NODISCARD
+    auto
+    window() const noexcept -> u32
+    {
+        return window_;
+    }
+
+    NODISCARD
+    auto
+    stride() const noexcept -> u32
+    {
+        return stride_;
+    }
+
+    auto
+    analyze(
+        const std::span<const u8> data,
+        section_stats&            stats
+    ) const -> void
+    {
+        stats.histogram.fill(0);
+        stats.windows.clear();
+
+        detail::byte_histogram(data.data(), data.size(), stats.histogram.data());
+
+        stats.entropy = shannon_entropy(stats.histogram);
+
+        if (data.size() < window_) {
+            return;
+        }
+
+        stats.windows.reserve((data.size() - window_) / stride_ + 1);
+
+        const auto* const bytes = data.data();
+        const auto        log2  = std::log2(static_cast<double>(window_));
+
+        byte_histogram counts{};
+        u64            sum{};
+
+        // runs of one value serialise on their count, eight equal bytes are moved at once
+        const auto enter = [&](const u8* const from, const szt size) {
+            szt i{};
+
+            for (; i + 8 <= size; i += 8) {
+                const auto word = bit::load_little<u64>(from + i);
+
+                if (word == static_cast<u8>(word) * 0x0101010101010101ull) {
+                    auto& count = counts[static_cast<u8>(word)];
+
+                    sum   += terms_[count + 8] - terms_[count];
+                    count += 8;
+                    continue;
+                }
+
+                for (szt j{}; j < 8; ++j) {
+                    auto& count = counts[from[i + j]];
+
+                    sum += terms_[count + 1] - terms_[count];
+                    ++count;
+                }
+            }
+
+            for (; i < size; ++i) {
+                auto& count = counts[from[i]];
+
+                sum += terms_[count + 1] - terms_[count];
+                ++count;
+            }
+        };
+
+        const auto leave = [&](const u8* const from, const szt size) {
+            szt i{};
+
+            for (; i + 8 <= size; i += 8) {
+                const auto word = bit::load_little<u64>(from + i);
+
+                if (word == static_cast<u8>(word) * 0x0101010101010101ull) {
+                    auto& count = counts[static_cast<u8>(word)];
+
+                    sum   -= terms_[count] - terms_[count - 8];
+                    count -= 8;
+                    continue;
+                }
+
+                for (szt j{}; j < 8; ++j) {
+                    auto& count = counts[from[i + j]];
+
+                    sum -= terms_[count] - terms_[count - 1];
+                    --count;
+                }
+            }
+
+            for (; i < size; ++i) {
+                auto& count = counts[from[i]];
+
+                sum -= terms_[count] - terms_[count - 1];
+                --count;
+            }
+        };
+
+        const auto entropy = [&] {
+            return static_cast<float>(log2 - static_cast<double>(sum) / fixed_one / window_);
+        };
+
+        enter(bytes, window_);
+        stats.windows.push_back(entropy());
+
+        for (szt begin = stride_; begin + window_ <= data.size(); begin += stride_) {
+            const auto previous = begin - stride_;
+
+            if (stride_ < window_) {
+                leave(bytes + previous, stride_);
+                enter(bytes + previous + window_, stride_);
+            } else {
+                // nothing is shared, clearing the 1 KB of counts beats taking every byte out
+                counts.fill(0);
+                sum = 0;
+                enter(bytes + begin, window_);
+            }
+
+            stats.windows.push_back(entropy());
+        }
+    }
+
+private:
+    constexpr static double fixed_one = 4294967296.0;
+
+    u32              window_;
+    u32              stride_;
+    std::vector<u64> terms_;
+};
+} //namespace zen::win
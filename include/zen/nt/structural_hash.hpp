@@ -0,0 +1,119 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/minhash.hpp>
+#include <zen/nt/export_index.hpp>
+#include <zen/nt/imphash.hpp>
+#include <bit>
+#include <vector>
+
+namespace zen::win {
+enum struct structural_features : u32
+{
+    imports  = 0x01,
+    exports  = 0x02,
+    sections = 0x04,
+    all      = imports | exports | sections,
+};
+ZEN_ENUM_OPERATORS(structural_features);
+
+// Tokens describing the structure of an image, every feature set hashes into its own domain:
+//
+//   imports  - "module.function" with the imphash spelling of the module
+//   exports  - every exported name
+//   sections - name plus the log2 buckets of the virtual and raw size, and each pair of
+//              neighbouring section names so the layout counts as well
+template<bool X64 = detail::is_64_bit>
+NODISCARD
+auto
+structural_tokens(
+    const image<X64>&         img,
+    const structural_features features = structural_features::all
+) -> std::vector<u32>
+{
+    std::vector<u32> tokens;
+
+    if ((features & structural_features::imports) == structural_features::imports) {
+        for_each_import(img, [&tokens](const std::string_view module, const std::string_view function) {
+            char       buffer[512];
+            const auto prefix = imphash_module_name(module).substr(0, 255);
+            const auto name   = function.substr(0, sizeof(buffer) - prefix.size() - 1);
+
+            std::copy(prefix.begin(), prefix.end(), buffer);
+            buffer[prefix.size()] = '.';
+            std::copy(name.begin(), name.end(), buffer + prefix.size() + 1);
+
+            tokens.push_back(minhash_token({buffer, prefix.size() + 1 + name.size()}, 1));
+        });
+    }
+
+    if ((features & structural_features::exports) == structural_features::exports) {
+        const export_index<X64> exports{img};
+
+        for (szt i{}; i < exports.num_names(); ++i) {
+            tokens.push_back(minhash_token(exports.name_at(i), 2));
+        }
+    }
+
+    if ((features & structural_features::sections) == structural_features::sections) {
+        const auto* const nt = img.nt_hdr();
+        std::string_view  previous;
+
+        for (szt i{}; i < nt->file_hdr().num_sections(); ++i) {
+            const auto* const scn  = nt->section(i);
+            const auto        name = scn->name().string().substr(0, 8);
+
+            const auto sizes = static_cast<u32>(std::bit_width(scn->virtual_size()) << 8 | std::bit_width(scn->size_raw_data()) << 16);
+
+            tokens.push_back(minhash_token(name, 3 | sizes));
+            tokens.push_back(minhash_token(name, minhash_token(previous, 4)));
+
+            previous = name;
+        }
+    }
+
+    std::sort(tokens.begin(), tokens.end());
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+
+    return tokens;
+}
+
+// MinHash signature of the structural tokens, ready for zen::similarity() or an lsh_index.
+template<szt K = 128, bool X64 = detail::is_64_bit>
+NODISCARD
+auto
+structural_minhash(
+    const image<X64>&         img,
+    const structural_features features = structural_features::all
+) -> minhash_signature<K>
+{
+    minhash<K> hasher;
+
+    hasher.update(structural_tokens(img, features));
+
+    return hasher.signature();
+}
+} //namespace zen::win
@@ -0,0 +1,478 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/platform/posix/mapped_file.hpp>
+#include <zen/nt/directories/relocs.hpp>
+#include <zen/nt/image.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace zen::posix {
+NODISCARD
+constexpr
+auto
+section_protection(
+    const win::section_characteristics characteristics
+) noexcept -> int
+{
+    auto protection = PROT_NONE;
+
+    if (characteristics.mem_read) {
+        protection |= PROT_READ;
+    }
+    if (characteristics.mem_write) {
+        protection |= PROT_WRITE;
+    }
+    if (characteristics.mem_execute) {
+        protection |= PROT_EXEC;
+    }
+
+    return protection;
+}
+
+// Validates the headers of a file layout image before any of them are trusted.
+template<bool X64 = detail::is_64_bit>
+NODISCARD
+inline
+auto
+image_headers(
+    const std::span<const u8> file
+) noexcept -> const win::nt_headers<X64>*
+{
+    if (file.size() < sizeof(win::dos_header)) {
+        return nullptr;
+    }
+
+    const auto* const dos = reinterpret_cast<const win::dos_header*>(file.data());
+    const auto        lfa = static_cast<szt>(dos->next_hdr_offset());
+
+    if (!dos->valid() || lfa + sizeof(win::nt_headers<X64>) > file.size()) {
+        return nullptr;
+    }
+
+    const auto* const nt = dos->nt_hdr<X64>();
+
+    if (!nt->valid() || nt->optional_hdr().is_64_bit() != X64) {
+        return nullptr;
+    }
+
+    const auto scn_offset = lfa
+        + sizeof(u32)
+        + sizeof(win::file_header)
+        + nt->file_hdr().size_optional_header();
+
+    if (scn_offset + nt->file_hdr().num_sections() * sizeof(win::section_header) > file.size()) {
+        return nullptr;
+    }
+
+    return nt;
+}
+
+// Maps a file layout image into memory layout the way the NT loader does for SEC_IMAGE
+// sections: the whole image range is reserved up front and every page aligned part of
+// a section is mapped directly from the file (MAP_PRIVATE), so untouched pages stay
+// shared with the page cache. Partial pages are copied and virtual tails are left to
+// the anonymous reservation, which the kernel zero-fills on first access.
+template<bool X64 = detail::is_64_bit>
+class image_mapping
+{
+    struct region
+    {
+        u32 rva{};
+        u32 size{};
+        int protection{};
+    };
+
+public:
+    constexpr
+    image_mapping() noexcept = default;
+
+    explicit
+    image_mapping(
+        const mapped_file& file
+    ) noexcept
+    {
+        if (!map(file.bytes(), file.fd())) {
+            reset();
+        }
+    }
+
+    explicit
+    image_mapping(
+        const std::span<const u8> file
+    ) noexcept
+    {
+        if (!map(file, -1)) {
+            reset();
+        }
+    }
+
+    image_mapping(
+        const image_mapping& rhs
+    ) = delete;
+
+    image_mapping(
+        image_mapping&& rhs
+    ) noexcept
+        : base_{rhs.base_}
+        , size_{rhs.size_}
+        , regions_{std::move(rhs.regions_)}
+    {
+        rhs.base_ = nullptr;
+        rhs.size_ = 0;
+    }
+
+    ~image_mapping() noexcept
+    {
+        reset();
+    }
+
+    auto
+    operator=(
+        const image_mapping& rhs
+    ) -> image_mapping& = delete;
+
+    auto
+    operator=(
+        image_mapping&& rhs
+    ) noexcept -> image_mapping&
+    {
+        if (this != &rhs) {
+            reset();
+
+            base_    = rhs.base_;
+            size_    = rhs.size_;
+            regions_ = std::move(rhs.regions_);
+
+            rhs.base_ = nullptr;
+            rhs.size_ = 0;
+        }
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return base_ != nullptr;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    base() const noexcept -> u8*
+    {
+        return base_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    size() const noexcept -> szt
+    {
+        return size_;
+    }
+
+    NODISCARD
+    auto
+    image() const noexcept -> win::image<X64>*
+    {
+        return reinterpret_cast<win::image<X64>*>(base_);
+    }
+
+    template<class T = u8>
+    NODISCARD
+    auto
+    rva_to_ptr(
+        const u32 rva,
+        const szt length = 1
+    ) const noexcept -> T*
+    {
+        if (!valid() || static_cast<szt>(rva) + length > size_) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<T*>(base_ + rva);
+    }
+
+    auto
+    relocate(
+        const u64 new_base
+    ) noexcept -> bool
+    {
+        if (!valid()) {
+            return false;
+        }
+
+        auto* const opt   = image()->optional_hdr();
+        const auto  delta = static_cast<i64>(new_base - static_cast<u64>(opt->image_base()));
+
+        if (delta == 0) {
+            return true;
+        }
+
+        const auto* const dir = image()->directory(win::directory::basereloc);
+
+        if (!dir || static_cast<szt>(dir->rva()) + dir->size() > size_) {
+            return false;
+        }
+
+        protect(PROT_READ | PROT_WRITE);
+
+        auto        success = true;
+        const auto* block   = reinterpret_cast<const win::reloc_block*>(base_ + dir->rva());
+        const auto* end     = reinterpret_cast<const win::reloc_block*>(base_ + dir->rva() + dir->size());
+
+        const auto remaining = [&end](const win::reloc_block* const at) {
+            return static_cast<szt>(reinterpret_cast<const u8*>(end) - reinterpret_cast<const u8*>(at));
+        };
+
+        while (remaining(block) >= sizeof(u32) * 2 && block->size_block() >= sizeof(u32) * 2) {
+            // a block running past the directory is malformed, nothing behind it can be trusted
+            if (block->size_block() > remaining(block)) {
+                success = false;
+                break;
+            }
+
+            for (const auto* entry = block->begin(); entry < block->end(); ++entry) {
+                const auto rva = static_cast<szt>(block->base_rva()) + entry->offset();
+
+                if (rva + win::reloc_width(entry->type()) > size_) {
+                    success = false;
+                    continue;
+                }
+
+                success &= win::apply_relocation(base_ + rva, entry->type(), delta);
+            }
+
+            block = block->next();
+        }
+
+        opt->image_base(static_cast<va_t<X64>>(new_base));
+
+        protect();
+
+        return success;
+    }
+
+    auto
+    protect(
+        const int override_protection = -1
+    ) const noexcept -> void
+    {
+        for (const auto& scn : regions_) {
+            ::mprotect(
+                base_ + scn.rva,
+                scn.size,
+                override_protection != -1 ? override_protection : scn.protection
+            );
+        }
+    }
+
+    auto
+    reset() noexcept -> void
+    {
+        if (base_) {
+            ::munmap(base_, size_);
+        }
+
+        base_ = nullptr;
+        size_ = 0;
+
+        regions_.clear();
+    }
+
+private:
+    NODISCARD
+    static
+    auto
+    align_up(
+        const szt value,
+        const szt alignment
+    ) noexcept -> szt
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    auto
+    map_range(
+        const std::span<const u8> file,
+        const int                 fd,
+        const u32                 rva,
+        const u32                 offset,
+        szt                       raw_size,
+        szt                       virtual_size,
+        const int                 protection
+    ) noexcept -> bool
+    {
+        const auto page = page_size();
+
+        if (rva >= size_) {
+            return true;
+        }
+
+        virtual_size = std::min(virtual_size, size_ - rva);
+
+        if (offset >= file.size()) {
+            raw_size = 0;
+        }
+
+        raw_size = std::min({raw_size, virtual_size, file.size() - std::min<szt>(offset, file.size())});
+
+        szt mapped{};
+
+        if (fd >= 0 && rva % page == 0 && offset % page == 0) {
+            mapped = raw_size & ~(page - 1);
+
+            if (
+                mapped != 0
+                && ::mmap(base_ + rva, mapped, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, offset) == MAP_FAILED
+            ) {
+                return false;
+            }
+        }
+
+        if (raw_size > mapped) {
+            auto* const tail = base_ + rva + mapped;
+            const auto  from = reinterpret_cast<uptr>(tail) & ~(page - 1);
+
+            ::mprotect(
+                reinterpret_cast<void*>(from),
+                align_up(reinterpret_cast<uptr>(tail) + raw_size - mapped, page) - from,
+                PROT_READ | PROT_WRITE
+            );
+
+            std::memcpy(tail, file.data() + offset + mapped, raw_size - mapped);
+        }
+
+        regions_.push_back({
+            .rva        = rva,
+            .size       = static_cast<u32>(align_up(virtual_size, page)),
+            .protection = protection,
+        });
+
+        return true;
+    }
+
+    auto
+    map(
+        const std::span<const u8> file,
+        int                       fd
+    ) noexcept -> bool
+    {
+        const auto* const nt = image_headers<X64>(file);
+
+        if (!nt) {
+            return false;
+        }
+
+        const auto  page = page_size();
+        const auto& opt  = nt->optional_hdr();
+
+        size_ = align_up(opt.size_image(), page);
+
+        if (size_ == 0 || opt.size_headers() > size_) {
+            return false;
+        }
+
+        auto* const reserved = ::mmap(
+            nullptr,
+            size_,
+            PROT_NONE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+            -1,
+            0
+        );
+
+        if (reserved == MAP_FAILED) {
+            size_ = 0;
+            return false;
+        }
+
+        base_ = static_cast<u8*>(reserved);
+
+        // Images with a section alignment below the page size share pages between
+        // sections, they can only be built by copying into a single writable range.
+        const auto flat = opt.section_alignment() < page;
+
+        if (flat) {
+            fd = -1;
+        }
+
+        if (!map_range(file, fd, 0, 0, opt.size_headers(), opt.size_headers(), PROT_READ)) {
+            return false;
+        }
+
+        auto flat_protection = PROT_READ | PROT_WRITE;
+
+        for (const auto& scn : nt->template sections<true>()) {
+            const auto raw_size     = scn.ptr_raw_data() != 0 ? scn.size_raw_data() : 0u;
+            const auto virtual_size = scn.virtual_size() != 0 ? scn.virtual_size() : scn.size_raw_data();
+            const auto protection   = section_protection(scn.characteristics());
+
+            flat_protection |= protection;
+
+            if (
+                !map_range(
+                    file,
+                    fd,
+                    scn.virtual_address(),
+                    scn.ptr_raw_data(),
+                    raw_size,
+                    virtual_size,
+                    protection
+                )
+            ) {
+                return false;
+            }
+        }
+
+        if (flat) {
+            regions_.assign(1, {.rva = 0, .size = static_cast<u32>(size_), .protection = flat_protection});
+        }
+
+        protect();
+
+        return true;
+    }
+
+    u8*                 base_{};
+    szt                 size_{};
+    std::vector<region> regions_;
+};
+} //namespace zen::posix
@@ -0,0 +1,545 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/platform/posix/mapped_file.hpp>
+#include <zen/nt/image.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace zen::posix {
+// Immutable backing store for image snapshots. The bytes are copied once into an anonymous
+// shared memory object, every snapshot maps that object MAP_PRIVATE, so pages are shared until
+// a snapshot writes to them.
+class snapshot_source
+{
+public:
+    constexpr
+    snapshot_source() noexcept = default;
+
+    explicit
+    snapshot_source(
+        const std::span<const u8> bytes
+    ) noexcept
+    {
+        if (bytes.empty()) {
+            return;
+        }
+
+        const auto fd = create_object();
+
+        if (fd < 0) {
+            return;
+        }
+
+        if (::ftruncate(fd, static_cast<off_t>(bytes.size())) != 0 || !write_all(fd, bytes)) {
+            ::close(fd);
+            return;
+        }
+
+#if defined(F_ADD_SEALS)
+        // best effort, only memfd objects support seals
+        ::fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+#endif
+
+        auto* const data = ::mmap(nullptr, bytes.size(), PROT_READ, MAP_SHARED, fd, 0);
+
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            return;
+        }
+
+        fd_   = fd;
+        data_ = static_cast<const u8*>(data);
+        size_ = bytes.size();
+    }
+
+    snapshot_source(
+        const snapshot_source& rhs
+    ) = delete;
+
+    snapshot_source(
+        snapshot_source&& rhs
+    ) noexcept
+        : fd_{rhs.fd_}
+        , data_{rhs.data_}
+        , size_{rhs.size_}
+    {
+        rhs.fd_   = -1;
+        rhs.data_ = nullptr;
+        rhs.size_ = 0;
+    }
+
+    ~snapshot_source() noexcept
+    {
+        reset();
+    }
+
+    auto
+    operator=(
+        const snapshot_source& rhs
+    ) -> snapshot_source& = delete;
+
+    auto
+    operator=(
+        snapshot_source&& rhs
+    ) noexcept -> snapshot_source&
+    {
+        if (this != &rhs) {
+            reset();
+
+            fd_   = rhs.fd_;
+            data_ = rhs.data_;
+            size_ = rhs.size_;
+
+            rhs.fd_   = -1;
+            rhs.data_ = nullptr;
+            rhs.size_ = 0;
+        }
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return data_ != nullptr;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    fd() const noexcept -> int
+    {
+        return fd_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    data() const noexcept -> const u8*
+    {
+        return data_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    size() const noexcept -> szt
+    {
+        return size_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    bytes() const noexcept -> std::span<const u8>
+    {
+        return {data_, size_};
+    }
+
+    auto
+    reset() noexcept -> void
+    {
+        if (data_) {
+            ::munmap(const_cast<u8*>(data_), size_);
+        }
+
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+
+        fd_   = -1;
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+private:
+    NODISCARD
+    static
+    auto
+    create_object() noexcept -> int
+    {
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+        if (const auto fd = ::memfd_create("zen-snapshot", MFD_CLOEXEC | MFD_ALLOW_SEALING); fd >= 0) {
+            return fd;
+        }
+#endif
+
+        char name[64];
+
+        for (u32 attempt{}; attempt < 16; ++attempt) {
+            std::snprintf(
+                name,
+                sizeof(name),
+                "/zen-snapshot-%ld-%p-%u",
+                static_cast<long>(::getpid()),
+                static_cast<const void*>(name),
+                attempt
+            );
+
+            const auto fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+
+            if (fd >= 0) {
+                ::shm_unlink(name);
+
+                return fd;
+            }
+
+            if (errno != EEXIST) {
+                break;
+            }
+        }
+
+        return -1;
+    }
+
+    NODISCARD
+    static
+    auto
+    write_all(
+        const int                 fd,
+        const std::span<const u8> bytes
+    ) noexcept -> bool
+    {
+        for (szt offset{}; offset < bytes.size();) {
+            const auto written = ::pwrite(
+                fd,
+                bytes.data() + offset,
+                bytes.size() - offset,
+                static_cast<off_t>(offset)
+            );
+
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if (written <= 0) {
+                return false;
+            }
+
+            offset += static_cast<szt>(written);
+        }
+
+        return true;
+    }
+
+    int       fd_{-1};
+    const u8* data_{};
+    szt       size_{};
+};
+
+// Writable view of a snapshot_source. Writes only copy the touched pages, so hundreds of
+// variants of a large image cost little more than the pages they modify. The source has to
+// outlive every snapshot created from it.
+template<bool X64 = detail::is_64_bit>
+class image_snapshot
+{
+public:
+    constexpr
+    image_snapshot() noexcept = default;
+
+    explicit
+    image_snapshot(
+        const snapshot_source& source
+    ) noexcept
+    {
+        if (!source) {
+            return;
+        }
+
+        auto* const data = ::mmap(
+            nullptr,
+            source.size(),
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE,
+            source.fd(),
+            0
+        );
+
+        if (data == MAP_FAILED) {
+            return;
+        }
+
+        source_ = &source;
+        data_   = static_cast<u8*>(data);
+        size_   = source.size();
+    }
+
+    image_snapshot(
+        const image_snapshot& rhs
+    ) = delete;
+
+    image_snapshot(
+        image_snapshot&& rhs
+    ) noexcept
+        : source_{rhs.source_}
+        , data_{rhs.data_}
+        , size_{rhs.size_}
+    {
+        rhs.source_ = nullptr;
+        rhs.data_   = nullptr;
+        rhs.size_   = 0;
+    }
+
+    ~image_snapshot() noexcept
+    {
+        reset();
+    }
+
+    auto
+    operator=(
+        const image_snapshot& rhs
+    ) -> image_snapshot& = delete;
+
+    auto
+    operator=(
+        image_snapshot&& rhs
+    ) noexcept -> image_snapshot&
+    {
+        if (this != &rhs) {
+            reset();
+
+            source_ = rhs.source_;
+            data_   = rhs.data_;
+            size_   = rhs.size_;
+
+            rhs.source_ = nullptr;
+            rhs.data_   = nullptr;
+            rhs.size_   = 0;
+        }
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return data_ != nullptr;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    data() const noexcept -> u8*
+    {
+        return data_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    size() const noexcept -> szt
+    {
+        return size_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    bytes() const noexcept -> std::span<u8>
+    {
+        return {data_, size_};
+    }
+
+    NODISCARD
+    auto
+    image() const noexcept -> win::image<X64>*
+    {
+        return reinterpret_cast<win::image<X64>*>(data_);
+    }
+
+    NODISCARD
+    auto
+    num_pages() const noexcept -> szt
+    {
+        return (size_ + page_size() - 1) / page_size();
+    }
+
+    // Returns the indexes of every page that has been written to since the snapshot was created
+    // or last reverted. Uses /proc/self/pagemap when available: a private page that is no longer
+    // backed by the shared object has been copied on write. Otherwise every page is compared
+    // against the source.
+    NODISCARD
+    auto
+    diff() const -> std::vector<szt>
+    {
+        std::vector<szt> result;
+
+        if (!valid()) {
+            return result;
+        }
+
+        if (!diff_pagemap(result)) {
+            result.clear();
+            diff_compare(result);
+        }
+
+        return result;
+    }
+
+    // Discards the private copy of a single page, it reads from the source again afterwards.
+    auto
+    revert(
+        const szt page
+    ) noexcept -> bool
+    {
+        if (!valid() || page >= num_pages()) {
+            return false;
+        }
+
+        const auto offset = page * page_size();
+
+        return remap(offset, std::min(page_size(), size_ - offset));
+    }
+
+    auto
+    revert() noexcept -> bool
+    {
+        return valid() && remap(0, size_);
+    }
+
+    auto
+    reset() noexcept -> void
+    {
+        if (data_) {
+            ::munmap(data_, size_);
+        }
+
+        source_ = nullptr;
+        data_   = nullptr;
+        size_   = 0;
+    }
+
+private:
+    auto
+    remap(
+        const szt offset,
+        const szt length
+    ) noexcept -> bool
+    {
+        return ::mmap(
+            data_ + offset,
+            length,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_FIXED,
+            source_->fd(),
+            static_cast<off_t>(offset)
+        ) != MAP_FAILED;
+    }
+
+    auto
+    diff_pagemap(
+        std::vector<szt>& result
+    ) const -> bool
+    {
+#if defined(__linux__)
+        constexpr u64 page_present = 1ull << 63;
+        constexpr u64 page_swapped = 1ull << 62;
+        constexpr u64 page_shared  = 1ull << 61;  // file page or shared anonymous page
+
+        const auto fd = ::open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0) {
+            return false;
+        }
+
+        const auto       first = reinterpret_cast<uptr>(data_) / page_size();
+        const auto       count = num_pages();
+        std::vector<u64> entries(count);
+
+        const auto expected = static_cast<ssize_t>(count * sizeof(u64));
+        const auto read     = ::pread(
+            fd,
+            entries.data(),
+            count * sizeof(u64),
+            static_cast<off_t>(first * sizeof(u64))
+        );
+
+        ::close(fd);
+
+        if (read != expected) {
+            return false;
+        }
+
+        for (szt i{}; i < count; ++i) {
+            const auto entry = entries[i];
+
+            if ((entry & (page_present | page_swapped)) && !(entry & page_shared)) {
+                result.push_back(i);
+            }
+        }
+
+        return true;
+#else
+        static_cast<void>(result);
+
+        return false;
+#endif
+    }
+
+    auto
+    diff_compare(
+        std::vector<szt>& result
+    ) const -> void
+    {
+        const auto page = page_size();
+
+        for (szt offset{}, i{}; offset < size_; offset += page, ++i) {
+            if (std::memcmp(data_ + offset, source_->data() + offset, std::min(page, size_ - offset)) != 0) {
+                result.push_back(i);
+            }
+        }
+    }
+
+    const snapshot_source* source_{};
+    u8*                    data_{};
+    szt                    size_{};
+};
+} //namespace zen::posix
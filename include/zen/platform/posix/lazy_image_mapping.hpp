@@ -0,0 +1,887 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/platform/posix/image_mapping.hpp>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <signal.h>
+#include <thread>
+#if defined(__linux__)
+#include <linux/userfaultfd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+namespace zen::posix {
+enum struct fault_mode : u8
+{
+    none,
+    userfaultfd,
+    signal,
+};
+
+struct fault_target
+{
+    u8*   begin{};
+    u8*   end{};
+    void* context{};
+    bool  (*handler)(void* context, u8* address) noexcept{};
+};
+
+// Process wide SIGSEGV dispatch for lazily materialized mappings. Targets live in a fixed table
+// of atomic slots so the handler never takes a lock, faults outside every target are passed on
+// to whichever handler was installed before.
+class fault_registry
+{
+public:
+    NODISCARD
+    static
+    auto
+    add(
+        fault_target* const target
+    ) noexcept -> bool
+    {
+        if (!install()) {
+            return false;
+        }
+
+        for (auto& slot : slots_) {
+            fault_target* expected{};
+
+            if (slot.compare_exchange_strong(expected, target, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static
+    auto
+    remove(
+        fault_target* const target
+    ) noexcept -> void
+    {
+        for (auto& slot : slots_) {
+            auto* expected = target;
+
+            slot.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+        }
+    }
+
+private:
+    NODISCARD
+    static
+    auto
+    install() noexcept -> bool
+    {
+        static const auto installed = [] {
+            struct sigaction action{};
+
+            action.sa_sigaction = &on_fault;
+            action.sa_flags     = SA_SIGINFO | SA_NODEFER;
+
+            sigemptyset(&action.sa_mask);
+
+            return ::sigaction(SIGSEGV, &action, &previous_) == 0;
+        }();
+
+        return installed;
+    }
+
+    static
+    auto
+    on_fault(
+        const int        signal,
+        siginfo_t* const info,
+        void* const      context
+    ) -> void
+    {
+        const auto saved_errno = errno;
+        auto* const address    = static_cast<u8*>(info->si_addr);
+
+        for (auto& slot : slots_) {
+            auto* const target = slot.load(std::memory_order_acquire);
+
+            if (target && address >= target->begin && address < target->end && target->handler(target->context, address)) {
+                errno = saved_errno;
+                return;
+            }
+        }
+
+        errno = saved_errno;
+
+        if ((previous_.sa_flags & SA_SIGINFO) != 0 && previous_.sa_sigaction) {
+            previous_.sa_sigaction(signal, info, context);
+        } else if (previous_.sa_handler == SIG_DFL) {
+            // faulting instruction is executed again and terminates the process as usual
+            ::sigaction(SIGSEGV, &previous_, nullptr);
+        } else if (previous_.sa_handler != SIG_IGN) {
+            previous_.sa_handler(signal);
+        }
+    }
+
+    static inline std::array<std::atomic<fault_target*>, 64> slots_{};
+    static inline struct sigaction                           previous_{};
+};
+
+// Memory layout image whose pages are built on first access: each page is assembled from the
+// file layout and has the base relocations that touch it applied before it becomes visible,
+// so the cost of mapping doesn't depend on the image size. Faults are served by a userfaultfd
+// thread when the kernel allows it, otherwise by a SIGSEGV handler on PROT_NONE pages. System
+// calls don't trigger either, so pages have to be touched before they are passed to the kernel.
+// The file has to outlive the mapping, which can't be moved since fault handlers refer to it.
+template<bool X64 = detail::is_64_bit>
+class lazy_image_mapping
+{
+    struct raw_range
+    {
+        u32 rva{};
+        u32 size{};
+        u32 offset{};
+    };
+
+    struct region
+    {
+        u32 rva{};
+        u32 size{};
+        int protection{};
+    };
+
+public:
+    lazy_image_mapping() noexcept = default;
+
+    lazy_image_mapping(
+        const mapped_file& file,
+        const u64          new_base
+    ) noexcept
+        : lazy_image_mapping{file.bytes(), new_base}
+    {}
+
+    lazy_image_mapping(
+        const std::span<const u8> file,
+        const u64                 new_base
+    ) noexcept
+    {
+        if (!map(file, new_base)) {
+            reset();
+        }
+    }
+
+    lazy_image_mapping(
+        const lazy_image_mapping& rhs
+    ) = delete;
+
+    ~lazy_image_mapping() noexcept
+    {
+        reset();
+    }
+
+    auto
+    operator=(
+        const lazy_image_mapping& rhs
+    ) -> lazy_image_mapping& = delete;
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return base_ != nullptr;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    base() const noexcept -> u8*
+    {
+        return base_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    size() const noexcept -> szt
+    {
+        return size_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    mode() const noexcept -> fault_mode
+    {
+        return mode_;
+    }
+
+    NODISCARD
+    auto
+    image() const noexcept -> win::image<X64>*
+    {
+        return reinterpret_cast<win::image<X64>*>(base_);
+    }
+
+    template<class T = u8>
+    NODISCARD
+    auto
+    rva_to_ptr(
+        const u32 rva,
+        const szt length = 1
+    ) const noexcept -> T*
+    {
+        if (!valid() || static_cast<szt>(rva) + length > size_) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<T*>(base_ + rva);
+    }
+
+    // Number of pages that have been built so far.
+    NODISCARD
+    auto
+    num_materialized() const noexcept -> szt
+    {
+        return materialized_.load(std::memory_order_relaxed);
+    }
+
+    auto
+    reset() noexcept -> void
+    {
+#if defined(__linux__)
+        if (worker_.joinable()) {
+            const u64 value = 1;
+
+            static_cast<void>(::write(wake_, &value, sizeof(value)));
+
+            worker_.join();
+        }
+
+        if (uffd_ >= 0) {
+            ::close(uffd_);
+        }
+
+        if (wake_ >= 0) {
+            ::close(wake_);
+        }
+
+        if (scratch_) {
+            ::munmap(scratch_, page_size());
+        }
+
+        uffd_    = -1;
+        wake_    = -1;
+        scratch_ = nullptr;
+#endif
+
+        if (mode_ == fault_mode::signal) {
+            fault_registry::remove(&target_);
+        }
+
+        if (base_) {
+            ::munmap(base_, size_);
+        }
+
+        base_ = nullptr;
+        size_ = 0;
+        mode_ = fault_mode::none;
+
+        ranges_.clear();
+        regions_.clear();
+        blocks_.clear();
+        page_blocks_.clear();
+        page_state_.reset();
+        materialized_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    NODISCARD
+    static
+    auto
+    align_up(
+        const szt value,
+        const szt alignment
+    ) noexcept -> szt
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    auto
+    copy_raw(
+        const u32 rva,
+        u8* const dst,
+        const szt length
+    ) const noexcept -> void
+    {
+        const auto begin = static_cast<u64>(rva);
+        const auto end   = begin + length;
+
+        for (const auto& range : ranges_) {
+            const auto from = std::max<u64>(begin, range.rva);
+            const auto to   = std::min<u64>(end, static_cast<u64>(range.rva) + range.size);
+
+            if (from < to) {
+                std::memcpy(dst + (from - begin), file_.data() + range.offset + (from - range.rva), to - from);
+            }
+        }
+    }
+
+    auto
+    compose(
+        const u32 rva,
+        u8* const dst
+    ) const noexcept -> void
+    {
+        const auto page = page_size();
+
+        std::memset(dst, 0, page);
+
+        copy_raw(rva, dst, page);
+
+        if (rva == 0) {
+            reinterpret_cast<win::dos_header*>(dst)->template nt_hdr<X64>()->optional_hdr().image_base(
+                static_cast<va_t<X64>>(new_base_)
+            );
+        }
+
+        if (delta_ == 0) {
+            return;
+        }
+
+        const auto index = rva / page;
+        const auto begin = static_cast<u64>(rva);
+        const auto end   = begin + page;
+
+        for (auto i = page_blocks_[index]; i < page_blocks_[index + 1]; ++i) {
+            const auto* const block = reinterpret_cast<const win::reloc_block*>(file_.data() + blocks_[i]);
+
+            for (const auto* entry = block->begin(); entry < block->end(); ++entry) {
+                const auto slot  = static_cast<u64>(block->base_rva()) + entry->offset();
+                const auto width = win::reloc_width(entry->type());
+
+                if (width == 0 || slot + width <= begin || slot >= end || slot + width > size_) {
+                    continue;
+                }
+
+                if (slot >= begin && slot + width <= end) {
+                    win::apply_relocation(dst + (slot - begin), entry->type(), delta_);
+                    continue;
+                }
+
+                // the slot straddles a page boundary, relocate a copy and keep our part of it
+                u8 value[sizeof(u64)]{};
+
+                copy_raw(static_cast<u32>(slot), value, width);
+                win::apply_relocation(value, entry->type(), delta_);
+
+                const auto from = std::max(slot, begin);
+                const auto to   = std::min(slot + width, end);
+
+                std::memcpy(dst + (from - begin), value + (from - slot), to - from);
+            }
+        }
+    }
+
+    NODISCARD
+    auto
+    page_protection(
+        const u32 rva
+    ) const noexcept -> int
+    {
+        auto protection = PROT_NONE;
+
+        for (const auto& scn : regions_) {
+            if (rva >= scn.rva && rva - scn.rva < scn.size) {
+                protection = scn.protection;
+            }
+        }
+
+        return protection;
+    }
+
+    auto
+    index_relocations() -> bool
+    {
+        const auto pages = size_ / page_size();
+
+        page_blocks_.assign(pages + 1, 0);
+
+        const auto* const img = reinterpret_cast<const win::image<X64>*>(file_.data());
+        const auto* const dir = img->directory(win::directory::basereloc);
+
+        if (delta_ == 0 || !dir || dir->size() == 0) {
+            return true;
+        }
+
+        const raw_range* source{};
+
+        for (const auto& range : ranges_) {
+            if (dir->rva() >= range.rva && static_cast<u64>(dir->rva()) + dir->size() <= static_cast<u64>(range.rva) + range.size) {
+                source = &range;
+            }
+        }
+
+        if (!source) {
+            return false;
+        }
+
+        struct span_entry
+        {
+            u32 offset;
+            u32 first;
+            u32 last;
+        };
+
+        std::vector<span_entry> spans;
+
+        const auto page  = page_size();
+        const auto begin = static_cast<szt>(source->offset) + (dir->rva() - source->rva);
+        const auto end   = begin + dir->size();
+
+        for (auto offset = begin; offset + sizeof(u32) * 2 <= end;) {
+            const auto* const block = reinterpret_cast<const win::reloc_block*>(file_.data() + offset);
+            const auto        size  = block->size_block();
+
+            if (size < sizeof(u32) * 2 || offset + size > end) {
+                break;
+            }
+
+            // entries reach 0xFFF bytes past the block base, plus the width of the widest slot
+            const auto first = block->base_rva() / page;
+            const auto last  = std::min<u64>((static_cast<u64>(block->base_rva()) + 0xFFF + sizeof(u64) - 1) / page, pages - 1);
+
+            if (first < pages) {
+                spans.push_back({static_cast<u32>(offset), static_cast<u32>(first), static_cast<u32>(last)});
+
+                for (auto i = first; i <= last; ++i) {
+                    ++page_blocks_[i + 1];
+                }
+            }
+
+            offset += size;
+        }
+
+        for (szt i{}; i < pages; ++i) {
+            page_blocks_[i + 1] += page_blocks_[i];
+        }
+
+        std::vector<u32> cursor(page_blocks_.begin(), page_blocks_.end() - 1);
+
+        blocks_.resize(page_blocks_.back());
+
+        for (const auto& entry : spans) {
+            for (auto i = entry.first; i <= entry.last; ++i) {
+                blocks_[cursor[i]++] = entry.offset;
+            }
+        }
+
+        return true;
+    }
+
+    auto
+    map(
+        const std::span<const u8> file,
+        const u64                 new_base
+    ) noexcept -> bool
+    {
+        const auto* const nt = image_headers<X64>(file);
+
+        if (!nt) {
+            return false;
+        }
+
+        const auto  page = page_size();
+        const auto& opt  = nt->optional_hdr();
+        const auto  lfa  = reinterpret_cast<const win::dos_header*>(file.data())->next_hdr_offset();
+
+        size_ = align_up(opt.size_image(), page);
+
+        // the header page is patched in place, so the nt headers have to live on it
+        if (size_ == 0 || opt.size_headers() > size_ || lfa + sizeof(win::nt_headers<X64>) > page) {
+            size_ = 0;
+            return false;
+        }
+
+        file_     = file;
+        new_base_ = new_base;
+        delta_    = static_cast<i64>(new_base - static_cast<u64>(opt.image_base()));
+
+        try {
+            const auto add_range = [&](const u32 rva, szt raw_size, const szt virtual_size, const u32 offset) {
+                if (offset >= file.size() || rva >= size_) {
+                    return;
+                }
+
+                raw_size = std::min({raw_size, virtual_size, file.size() - offset, size_ - rva});
+
+                if (raw_size != 0) {
+                    ranges_.push_back({rva, static_cast<u32>(raw_size), offset});
+                }
+            };
+
+            add_range(0, opt.size_headers(), opt.size_headers(), 0);
+            regions_.push_back({0, static_cast<u32>(align_up(opt.size_headers(), page)), PROT_READ});
+
+            auto flat_protection = PROT_READ | PROT_WRITE;
+
+            for (const auto& scn : nt->template sections<true>()) {
+                const auto raw_size     = scn.ptr_raw_data() != 0 ? scn.size_raw_data() : 0u;
+                const auto virtual_size = scn.virtual_size() != 0 ? scn.virtual_size() : scn.size_raw_data();
+                const auto protection   = section_protection(scn.characteristics());
+
+                add_range(scn.virtual_address(), raw_size, virtual_size, scn.ptr_raw_data());
+                regions_.push_back({scn.virtual_address(), static_cast<u32>(align_up(virtual_size, page)), protection});
+
+                flat_protection |= protection;
+            }
+
+            // same as image_mapping, sections sharing pages get one writable region
+            if (opt.section_alignment() < page) {
+                regions_.assign(1, {.rva = 0, .size = static_cast<u32>(size_), .protection = flat_protection});
+            }
+
+            if (!index_relocations()) {
+                return false;
+            }
+        } catch (...) {
+            return false;
+        }
+
+        return map_userfaultfd() || map_signal();
+    }
+
+    auto
+    map_userfaultfd() noexcept -> bool
+    {
+#if defined(__linux__) && defined(__NR_userfaultfd)
+        auto fd = static_cast<int>(::syscall(__NR_userfaultfd, O_CLOEXEC | O_NONBLOCK));
+
+        if (fd < 0 && errno == EPERM) {
+            fd = static_cast<int>(::syscall(__NR_userfaultfd, O_CLOEXEC | O_NONBLOCK | UFFD_USER_MODE_ONLY));
+        }
+
+        if (fd < 0) {
+            return false;
+        }
+
+        uffd_ = fd;
+
+        uffdio_api api{.api = UFFD_API, .features = 0, .ioctls = 0};
+
+        if (::ioctl(uffd_, UFFDIO_API, &api) != 0) {
+            return fail_userfaultfd();
+        }
+
+        auto* const reserved = ::mmap(
+            nullptr,
+            size_,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+            -1,
+            0
+        );
+
+        auto* const scratch = ::mmap(nullptr, page_size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        base_    = reserved != MAP_FAILED ? static_cast<u8*>(reserved) : nullptr;
+        scratch_ = scratch != MAP_FAILED ? static_cast<u8*>(scratch) : nullptr;
+
+        if (!base_ || !scratch_) {
+            return fail_userfaultfd();
+        }
+
+        uffdio_register registration{
+            .range  = {.start = reinterpret_cast<u64>(base_), .len = size_},
+            .mode   = UFFDIO_REGISTER_MODE_MISSING,
+            .ioctls = 0,
+        };
+
+        if (
+            ::ioctl(uffd_, UFFDIO_REGISTER, &registration) != 0
+            || (registration.ioctls & (1ull << _UFFDIO_COPY)) == 0
+        ) {
+            return fail_userfaultfd();
+        }
+
+        wake_ = ::eventfd(0, EFD_CLOEXEC);
+
+        if (wake_ < 0) {
+            return fail_userfaultfd();
+        }
+
+        ::mprotect(base_, size_, PROT_NONE);
+
+        for (const auto& scn : regions_) {
+            if (scn.rva < size_) {
+                ::mprotect(base_ + scn.rva, std::min<szt>(scn.size, size_ - scn.rva), scn.protection);
+            }
+        }
+
+        try {
+            worker_ = std::thread{[this] { serve(); }};
+        } catch (...) {
+            return fail_userfaultfd();
+        }
+
+        mode_ = fault_mode::userfaultfd;
+
+        return true;
+#else
+        return false;
+#endif
+    }
+
+#if defined(__linux__)
+    auto
+    fail_userfaultfd() noexcept -> bool
+    {
+        if (base_) {
+            ::munmap(base_, size_);
+        }
+
+        if (scratch_) {
+            ::munmap(scratch_, page_size());
+        }
+
+        if (uffd_ >= 0) {
+            ::close(uffd_);
+        }
+
+        if (wake_ >= 0) {
+            ::close(wake_);
+        }
+
+        base_    = nullptr;
+        scratch_ = nullptr;
+        uffd_    = -1;
+        wake_    = -1;
+
+        return false;
+    }
+
+    auto
+    serve() noexcept -> void
+    {
+        const auto page = page_size();
+
+        pollfd fds[2]{
+            {.fd = uffd_, .events = POLLIN, .revents = 0},
+            {.fd = wake_, .events = POLLIN, .revents = 0},
+        };
+
+        while (true) {
+            if (::poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                return;
+            }
+
+            if (fds[1].revents != 0) {
+                return;
+            }
+
+            uffd_msg message{};
+
+            if (::read(uffd_, &message, sizeof(message)) != sizeof(message) || message.event != UFFD_EVENT_PAGEFAULT) {
+                continue;
+            }
+
+            const auto address = message.arg.pagefault.address & ~static_cast<u64>(page - 1);
+
+            compose(static_cast<u32>(address - reinterpret_cast<u64>(base_)), scratch_);
+
+            uffdio_copy copy{
+                .dst  = address,
+                .src  = reinterpret_cast<u64>(scratch_),
+                .len  = page,
+                .mode = 0,
+                .copy = 0,
+            };
+
+            while (::ioctl(uffd_, UFFDIO_COPY, &copy) != 0 && errno == EAGAIN) {
+                copy.copy = 0;
+            }
+
+            // EEXIST: another fault on the same page was served first
+            if (copy.copy == static_cast<i64>(page)) {
+                materialized_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+#endif
+
+    auto
+    map_signal() noexcept -> bool
+    {
+        auto* const reserved = ::mmap(
+            nullptr,
+            size_,
+            PROT_NONE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+            -1,
+            0
+        );
+
+        if (reserved == MAP_FAILED) {
+            return false;
+        }
+
+        base_ = static_cast<u8*>(reserved);
+
+        page_state_.reset(new (std::nothrow) std::atomic<u8>[size_ / page_size()]{});
+
+        target_ = {
+            .begin   = base_,
+            .end     = base_ + size_,
+            .context = this,
+            .handler = &on_fault,
+        };
+
+        if (!page_state_ || !fault_registry::add(&target_)) {
+            return false;
+        }
+
+        mode_ = fault_mode::signal;
+
+        return true;
+    }
+
+    static
+    auto
+    on_fault(
+        void* const context,
+        u8* const   address
+    ) noexcept -> bool
+    {
+        return static_cast<lazy_image_mapping*>(context)->materialize(address);
+    }
+
+    // Runs inside the SIGSEGV handler, only async-signal-safe calls from here on.
+    auto
+    materialize(
+        u8* const address
+    ) noexcept -> bool
+    {
+        constexpr u8 state_missing = 0;
+        constexpr u8 state_busy    = 1;
+        constexpr u8 state_ready   = 2;
+
+        const auto page       = page_size();
+        const auto index      = static_cast<szt>(address - base_) / page;
+        const auto rva        = static_cast<u32>(index * page);
+        const auto protection = page_protection(rva);
+        auto&      state      = page_state_[index];
+
+        if (protection == PROT_NONE) {
+            return false;
+        }
+
+        auto expected = state_missing;
+
+        if (!state.compare_exchange_strong(expected, state_busy, std::memory_order_acq_rel)) {
+            // a fault on a page that's already built is a genuine access violation
+            if (expected == state_ready) {
+                return false;
+            }
+
+            while (state.load(std::memory_order_acquire) == state_busy) {
+                std::this_thread::yield();
+            }
+
+            return true;
+        }
+
+#if defined(MREMAP_FIXED)
+        // build the page off to the side and move it in, other threads never see it half done
+        auto* const scratch = ::mmap(nullptr, page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (scratch == MAP_FAILED) {
+            state.store(state_missing, std::memory_order_release);
+            return false;
+        }
+
+        compose(rva, static_cast<u8*>(scratch));
+
+        if (
+            ::mprotect(scratch, page, protection) != 0
+            || ::mremap(scratch, page, page, MREMAP_MAYMOVE | MREMAP_FIXED, base_ + rva) == MAP_FAILED
+        ) {
+            ::munmap(scratch, page);
+            state.store(state_missing, std::memory_order_release);
+            return false;
+        }
+#else
+        if (::mprotect(base_ + rva, page, PROT_READ | PROT_WRITE) != 0) {
+            state.store(state_missing, std::memory_order_release);
+            return false;
+        }
+
+        compose(rva, base_ + rva);
+
+        ::mprotect(base_ + rva, page, protection);
+#endif
+
+        state.store(state_ready, std::memory_order_release);
+        materialized_.fetch_add(1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    std::span<const u8>                  file_{};
+    u8*                                  base_{};
+    szt                                  size_{};
+    u64                                  new_base_{};
+    i64                                  delta_{};
+    fault_mode                           mode_{fault_mode::none};
+    std::vector<raw_range>               ranges_;
+    std::vector<region>                  regions_;
+    std::vector<u32>                     blocks_;
+    std::vector<u32>                     page_blocks_;
+    std::unique_ptr<std::atomic<u8>[]>   page_state_;
+    fault_target                         target_{};
+    std::atomic<szt>                     materialized_{};
+#if defined(__linux__)
+    int                                  uffd_{-1};
+    int                                  wake_{-1};
+    u8*                                  scratch_{};
+    std::thread                          worker_;
+#endif
+};
+} //namespace zen::posix
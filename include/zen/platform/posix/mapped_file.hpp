@@ -0,0 +1,212 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/requirements.hpp>
+#include <span>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace zen::posix {
+NODISCARD
+inline
+auto
+page_size() noexcept -> szt
+{
+    static const auto size = static_cast<szt>(::sysconf(_SC_PAGESIZE));
+
+    return size;
+}
+
+class mapped_file
+{
+public:
+    constexpr
+    mapped_file() noexcept = default;
+
+    explicit
+    mapped_file(
+        const char* const path
+    ) noexcept
+    {
+        const auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0) {
+            return;
+        }
+
+        struct stat info{};
+
+        if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return;
+        }
+
+        auto* const data = ::mmap(
+            nullptr,
+            static_cast<szt>(info.st_size),
+            PROT_READ,
+            MAP_PRIVATE,
+            fd,
+            0
+        );
+
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            return;
+        }
+
+        fd_   = fd;
+        data_ = static_cast<const u8*>(data);
+        size_ = static_cast<szt>(info.st_size);
+    }
+
+    mapped_file(
+        const mapped_file& rhs
+    ) = delete;
+
+    mapped_file(
+        mapped_file&& rhs
+    ) noexcept
+        : fd_{rhs.fd_}
+        , data_{rhs.data_}
+        , size_{rhs.size_}
+    {
+        rhs.fd_   = -1;
+        rhs.data_ = nullptr;
+        rhs.size_ = 0;
+    }
+
+    ~mapped_file() noexcept
+    {
+        reset();
+    }
+
+    auto
+    operator=(
+        const mapped_file& rhs
+    ) -> mapped_file& = delete;
+
+    auto
+    operator=(
+        mapped_file&& rhs
+    ) noexcept -> mapped_file&
+    {
+        if (this != &rhs) {
+            reset();
+
+            fd_   = rhs.fd_;
+            data_ = rhs.data_;
+            size_ = rhs.size_;
+
+            rhs.fd_   = -1;
+            rhs.data_ = nullptr;
+            rhs.size_ = 0;
+        }
+
+        return *this;
+    }
+
+    NODISCARD
+    constexpr
+    explicit
+    operator
+    bool() const noexcept
+    {
+        return valid();
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    valid() const noexcept -> bool
+    {
+        return data_ != nullptr;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    fd() const noexcept -> int
+    {
+        return fd_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    data() const noexcept -> const u8*
+    {
+        return data_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    size() const noexcept -> szt
+    {
+        return size_;
+    }
+
+    NODISCARD
+    constexpr
+    auto
+    bytes() const noexcept -> std::span<const u8>
+    {
+        return {data_, size_};
+    }
+
+    template<class T>
+    NODISCARD
+    auto
+    as() const noexcept -> const T*
+    {
+        return reinterpret_cast<const T*>(data_);
+    }
+
+    auto
+    reset() noexcept -> void
+    {
+        if (data_) {
+            ::munmap(const_cast<u8*>(data_), size_);
+        }
+
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+
+        fd_   = -1;
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+private:
+    int       fd_{-1};
+    const u8* data_{};
+    szt       size_{};
+};
+} //namespace zen::posix
@@ -0,0 +1,129 @@
+// Copyright (c) 2025 - 2026, neonbyte - All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the project nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <zen/core/requirements.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <span>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace zen::posix {
+// Writes `segments` back to back starting at `offset` with pwritev, one call unless there are more
+// than IOV_MAX segments or the kernel writes short. Nothing is copied into an intermediate buffer.
+NODISCARD
+inline
+auto
+write_segments(
+    const int                                  fd,
+    const std::span<const std::span<const u8>> segments,
+    off_t                                      offset = 0
+) noexcept -> bool
+{
+#if defined(IOV_MAX)
+    constexpr szt max_vectors = IOV_MAX;
+#else
+    constexpr szt max_vectors = 1024;
+#endif
+
+    iovec vectors[std::min<szt>(max_vectors, 1024)];
+
+    szt index{};
+    szt skip{};  // bytes of segments[index] already written
+
+    while (index < segments.size()) {
+        szt count{};
+
+        for (auto i = index; i < segments.size() && count < std::size(vectors); ++i) {
+            const auto segment = i == index ? segments[i].subspan(skip) : segments[i];
+
+            if (!segment.empty()) {
+                vectors[count++] = {const_cast<u8*>(segment.data()), segment.size()};
+            }
+        }
+
+        if (count == 0) {
+            return true;
+        }
+
+        const auto written = ::pwritev(fd, vectors, static_cast<int>(count), offset);
+
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (written <= 0) {
+            return false;
+        }
+
+        offset += written;
+
+        // advance past the fully written segments
+        for (auto left = static_cast<szt>(written); left != 0;) {
+            const auto remaining = segments[index].size() - skip;
+
+            if (left < remaining) {
+                skip += left;
+                break;
+            }
+
+            left -= remaining;
+            skip  = 0;
+            ++index;
+        }
+
+        while (index < segments.size() && segments[index].size() == skip) {
+            skip = 0;
+            ++index;
+        }
+    }
+
+    return true;
+}
+
+// Creates or truncates `path` and writes the segments into it.
+NODISCARD
+inline
+auto
+write_file(
+    const char* const                          path,
+    const std::span<const std::span<const u8>> segments,
+    const mode_t                               mode = 0644
+) noexcept -> bool
+{
+    const auto fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    const auto written = write_segments(fd, segments);
+
+    return ::close(fd) == 0 && written;
+}
+} //namespace zen::posix